@@ -0,0 +1,65 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** Bench.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <Game.hpp>
+
+#define BENCH_REPETITIONS 5
+
+struct BenchResult {
+    std::string name;
+    std::size_t entities;
+    std::size_t iterations;
+    double ns_per_op;       // median over BENCH_REPETITIONS
+    double ns_min;
+};
+
+class BenchRunner {
+ public:
+    using Function = std::function<void()>;
+
+    // Times `iterations` back-to-back calls, for sub-microsecond work
+    void run(const std::string& name, std::size_t entities,
+        std::size_t iterations, const Function& fn);
+    // Runs `setup` untimed before every timed call of `fn`
+    void run(const std::string& name, std::size_t entities,
+        std::size_t iterations, const Function& setup, const Function& fn);
+
+    void writeJson(std::ostream& out) const;
+
+ private:
+    std::vector<BenchResult> _results;
+
+    void record(const std::string& name, std::size_t entities,
+        std::size_t iterations, std::vector<double> samples);
+};
+
+// Server-side game without network nor display plugins
+class BenchGame : public Game {
+ public:
+    BenchGame();
+
+    void runAll(BenchRunner& runner);
+
+ private:
+    void populate(std::size_t players, std::size_t ennemies,
+        std::size_t projectiles);
+    // Per-slot removal loop, as the match reset used to do
+    void sweepFields();
+
+    void benchSnapshots(BenchRunner& runner);
+    void benchSpawning(BenchRunner& runner);
+    void benchSystems(BenchRunner& runner);
+    void benchReset(BenchRunner& runner);
+};
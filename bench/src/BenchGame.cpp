@@ -0,0 +1,200 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** BenchGame.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Protocol.hpp>
+#include <Snapshot.hpp>
+#include <waves.hpp>
+#include <Bench.hpp>
+
+static const std::vector<std::size_t> SNAPSHOT_SIZES = {10, 100, 1000};
+
+BenchGame::BenchGame() : Game("./bench/plugins") {
+    addConfig("config/entities/player.toml");
+    addConfig("config/entities/enemy1.toml");
+    addConfig("config/entities/enemy2.toml");
+    addConfig("config/entities/enemy3.toml");
+    addConfig("config/entities/enemy4.toml");
+    addConfig("config/entities/boundaries.toml");
+
+    createSystem("apply_pattern");
+    createSystem("movement2");
+    createSystem("bound_hitbox");
+    createSystem("deal_damage");
+    createSystem("apply_fragile");
+    createSystem("kill_entity");
+}
+
+void BenchGame::runAll(BenchRunner& runner) {
+    benchSnapshots(runner);
+    benchSpawning(runner);
+    benchSystems(runner);
+    benchReset(runner);
+}
+
+void BenchGame::populate(std::size_t players, std::size_t ennemies,
+    std::size_t projectiles) {
+    static const std::string shots[] = {"minigun", "rocket", "shotgun"};
+
+    for (std::size_t i = 0; i < players; ++i) {
+        createEntity(EntityField::PLAYER_BEGIN + i, "player",
+            {100.f, 50.f + (i % 10) * 60.f});
+    }
+    for (std::size_t i = 0; i < ennemies; ++i) {
+        createEntity(EntityField::ENEMIES_BEGIN + i,
+            "enemy" + std::to_string(i % 4 + 1),
+            {900.f + (i / 10) * 60.f, 20.f + (i % 10) * 65.f});
+    }
+    for (std::size_t i = 0; i < projectiles; ++i) {
+        createEntity(EntityField::PROJECTILES_BEGIN + i, shots[i % 3],
+            {200.f + (i / 20) * 20.f, 10.f + (i % 20) * 33.f});
+    }
+}
+
+void BenchGame::sweepFields() {
+    for (ECS::Entity e = EntityField::ENEMIES_BEGIN;
+         e < EntityField::ENEMIES_END; ++e)
+        removeEntity(e);
+    for (ECS::Entity e = EntityField::PROJECTILES_BEGIN;
+         e < EntityField::PROJECTILES_END; ++e)
+        removeEntity(e);
+    for (ECS::Entity e = EntityField::MAP_BEGIN;
+         e < EntityField::MAP_END; ++e)
+        removeEntity(e);
+    for (ECS::Entity e = EntityField::PLAYER_BEGIN;
+         e < EntityField::PLAYER_END; ++e)
+        removeEntity(e);
+}
+
+void BenchGame::benchSnapshots(BenchRunner& runner) {
+    std::vector<uint8_t> packet;
+    packet.reserve(1 << 16);
+
+    for (std::size_t size : SNAPSHOT_SIZES) {
+        std::size_t players = std::min<std::size_t>(size, PLAYERS_FIELD_SIZE);
+        std::size_t ennemies = std::min<std::size_t>(size,
+            ENNEMIES_FIELD_SIZE);
+        std::size_t projectiles = std::min<std::size_t>(size,
+            PROJECTILES_FIELD_SIZE);
+        clearMatchFields();
+        populate(players, ennemies, projectiles);
+
+        runner.run("encode_players", players, 2000, [&]() {
+            packet.assign(1, PLAYERS_DATA);
+            encodePlayersData(packet);
+        });
+        std::vector<uint8_t> players_data(packet.begin() + 1, packet.end());
+        runner.run("encode_ennemies", ennemies, 2000, [&]() {
+            packet.assign(1, ENNEMIES_DATA);
+            encodeEnnemiesData(packet);
+        });
+        std::vector<uint8_t> ennemies_data(packet.begin() + 1, packet.end());
+        runner.run("encode_projectiles", projectiles, 2000, [&]() {
+            packet.assign(1, PROJECTILES_DATA);
+            encodeProjectilesData(packet);
+        });
+        std::vector<uint8_t> projectiles_data(packet.begin() + 1,
+            packet.end());
+
+        std::vector<PlayerSnapshot> player_rows;
+        runner.run("decode_players", players, 2000, [&]() {
+            player_rows.clear();
+            snapshot::read(players_data, player_rows);
+        });
+        std::vector<EnnemySnapshot> ennemy_rows;
+        runner.run("decode_ennemies", ennemies, 2000, [&]() {
+            ennemy_rows.clear();
+            snapshot::read(ennemies_data, ennemy_rows);
+        });
+        std::vector<ProjectileSnapshot> projectile_rows;
+        runner.run("decode_projectiles", projectiles, 2000, [&]() {
+            projectile_rows.clear();
+            snapshot::read(projectiles_data, projectile_rows);
+        });
+    }
+    clearMatchFields();
+}
+
+void BenchGame::benchSpawning(BenchRunner& runner) {
+    ECS::Entity next = EntityField::PROJECTILES_BEGIN;
+
+    runner.run("create_entity", 1, 5000, [&]() {
+        if (next >= EntityField::PROJECTILES_END)
+            next = EntityField::PROJECTILES_BEGIN;
+        createEntity(next++, "minigun", {300.f, 300.f});
+    });
+    clearMatchFields();
+
+    for (std::size_t wave = 0; wave < NB_WAVES; ++wave) {
+        runner.run("create_mob_wave_" + std::to_string(wave),
+            WAVES[wave].size(), 200,
+            [&]() { clearMatchFields(); },
+            [&]() { createMobWave(wave); });
+    }
+    clearMatchFields();
+}
+
+void BenchGame::benchSystems(BenchRunner& runner) {
+    runner.run("run_systems_lobby", 4, 500,
+        [&]() { clearMatchFields(); populate(4, 0, 0); },
+        [&]() { runSystems(); });
+
+    for (std::size_t wave = 0; wave < NB_WAVES; ++wave) {
+        runner.run("run_systems_wave_" + std::to_string(wave),
+            WAVES[wave].size() + 4 + 100, 200,
+            [&]() {
+                clearMatchFields();
+                createBoundaries();
+                populate(4, 0, 100);
+                createMobWave(wave);
+            },
+            [&]() { runSystems(); });
+    }
+
+    runner.run("run_systems_projectiles", PROJECTILES_FIELD_SIZE, 100,
+        [&]() {
+            clearMatchFields();
+            createBoundaries();
+            populate(4, ENNEMIES_FIELD_SIZE, PROJECTILES_FIELD_SIZE);
+        },
+        [&]() { runSystems(); });
+    clearMatchFields();
+}
+
+void BenchGame::benchReset(BenchRunner& runner) {
+    std::size_t full = 4 + ENNEMIES_FIELD_SIZE + PROJECTILES_FIELD_SIZE;
+    auto fill = [&]() {
+        clearMatchFields();
+        createBoundaries();
+        populate(4, ENNEMIES_FIELD_SIZE, PROJECTILES_FIELD_SIZE);
+    };
+
+    runner.run("remove_entity_sweep_empty", 0, 200,
+        [&]() { clearMatchFields(); },
+        [&]() { sweepFields(); });
+    runner.run("remove_entity_sweep_full", full, 50, fill,
+        [&]() { sweepFields(); });
+
+    runner.run("clear_match_fields_empty", 0, 200,
+        [&]() { clearMatchFields(); },
+        [&]() { clearMatchFields(); });
+    runner.run("clear_match_fields_full", full, 50, fill,
+        [&]() { clearMatchFields(); });
+
+    for (std::size_t i = 0; i < 4; ++i)
+        setBaseline(EntityField::PLAYER_BEGIN + i, "player");
+    runner.run("restore_baseline_full", full, 50, fill,
+        [&]() { restoreBaseline(); });
+    for (std::size_t i = 0; i < 4; ++i)
+        unsetBaseline(EntityField::PLAYER_BEGIN + i);
+    clearMatchFields();
+}
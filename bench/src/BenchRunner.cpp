@@ -0,0 +1,75 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** BenchRunner.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Bench.hpp>
+
+using BenchClock = std::chrono::steady_clock;
+
+static double elapsedNs(BenchClock::time_point begin) {
+    return std::chrono::duration<double, std::nano>(
+        BenchClock::now() - begin).count();
+}
+
+void BenchRunner::run(const std::string& name, std::size_t entities,
+    std::size_t iterations, const Function& fn) {
+    std::vector<double> samples;
+
+    fn();
+    for (std::size_t rep = 0; rep < BENCH_REPETITIONS; ++rep) {
+        auto begin = BenchClock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            fn();
+        samples.push_back(elapsedNs(begin) / iterations);
+    }
+    record(name, entities, iterations, std::move(samples));
+}
+
+void BenchRunner::run(const std::string& name, std::size_t entities,
+    std::size_t iterations, const Function& setup, const Function& fn) {
+    std::vector<double> samples;
+
+    for (std::size_t rep = 0; rep < BENCH_REPETITIONS; ++rep) {
+        double total = 0.0;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            setup();
+            auto begin = BenchClock::now();
+            fn();
+            total += elapsedNs(begin);
+        }
+        samples.push_back(total / iterations);
+    }
+    record(name, entities, iterations, std::move(samples));
+}
+
+void BenchRunner::record(const std::string& name, std::size_t entities,
+    std::size_t iterations, std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    _results.push_back({name, entities, iterations,
+        samples[samples.size() / 2], samples.front()});
+}
+
+void BenchRunner::writeJson(std::ostream& out) const {
+    out << "{\"benchmarks\": [\n";
+    for (std::size_t i = 0; i < _results.size(); ++i) {
+        const auto& res = _results[i];
+        out << "  {\"name\": \"" << res.name << "\""
+            << ", \"entities\": " << res.entities
+            << ", \"iterations\": " << res.iterations
+            << ", \"ns_per_op\": " << res.ns_per_op
+            << ", \"ns_min\": " << res.ns_min << "}"
+            << (i + 1 < _results.size() ? ",\n" : "\n");
+    }
+    out << "]}\n";
+}
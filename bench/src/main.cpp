@@ -0,0 +1,38 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** bench_main.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <Bench.hpp>
+
+int main(int argc, char** argv) {
+    std::string out_path;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--out" && i + 1 < argc)
+            out_path = argv[++i];
+    }
+
+    BenchRunner runner;
+    BenchGame game;
+
+    game.runAll(runner);
+
+    if (out_path.empty()) {
+        runner.writeJson(std::cout);
+        return 0;
+    }
+    std::ofstream file(out_path);
+    if (!file.is_open()) {
+        std::cerr << "Cannot open " << out_path << "\n";
+        return 1;
+    }
+    runner.writeJson(file);
+    return 0;
+}
@@ -0,0 +1,50 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** AssetPrefetcher.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+#define ASSETS_DIR "./client/assets"
+
+// Prefetch plus incremental loading, the engine only loads synchronously:
+// - a background thread reads every file under `dir` once, so the first
+//   texture loads hit the page cache instead of the disk. It loads
+//   nothing itself.
+// - entity names queued with warm() are handed back one per frame by
+//   next(), the client instantiates them once on the main thread so their
+//   textures are loaded before the entity is needed for real
+class AssetPrefetcher {
+ public:
+    explicit AssetPrefetcher(const std::string& dir);
+    ~AssetPrefetcher();
+
+    AssetPrefetcher(const AssetPrefetcher&) = delete;
+    AssetPrefetcher& operator=(const AssetPrefetcher&) = delete;
+
+    // Queued once per name, later calls are ignored
+    void warm(const std::string& entity_name);
+    std::optional<std::string> next();
+
+    bool filesDone() const { return _files_done; }
+
+ private:
+    std::atomic<bool> _stop{false};
+    std::atomic<bool> _files_done{false};
+    std::thread _reader;
+
+    std::deque<std::string> _queue;
+    std::unordered_set<std::string> _warmed;
+
+    void readFiles(const std::string& dir);
+};
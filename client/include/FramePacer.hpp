@@ -0,0 +1,47 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** FramePacer.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <chrono>
+
+// Paces the client loop on three independent rates: network polling,
+// input sampling and rendering. wait() sleeps until the earliest one is
+// due instead of spinning, a rate of 0 means "every loop iteration".
+class FramePacer {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    FramePacer(float render_hz, float network_hz, float input_hz);
+
+    void wait();
+
+    bool renderDue() { return _render.due(Clock::now()); }
+    bool networkDue() { return _network.due(Clock::now()); }
+    bool inputDue() { return _input.due(Clock::now()); }
+
+    // seconds between two network polls
+    float networkStep() const;
+
+    void setRenderRate(float hz) { _render.setRate(hz); }
+    float renderRate() const { return _render.hz; }
+
+ private:
+    struct Rate {
+        float hz = 0.0f;
+        Clock::duration period{};
+        Clock::time_point next{};
+
+        void setRate(float rate);
+        bool due(Clock::time_point now);
+    };
+
+    Rate _render;
+    Rate _network;
+    Rate _input;
+};
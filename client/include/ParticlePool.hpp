@@ -0,0 +1,66 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** ParticlePool.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Fixed-capacity pool of cosmetic particles, stored as parallel arrays.
+// Every kind owns a fixed range of slots and a particle keeps its slot for
+// its whole life, so slot i can be mapped to a client-side entity created
+// once with the right sprite. When a kind is full its oldest particle is
+// recycled instead of allocating.
+class ParticlePool {
+ public:
+    enum Kind : uint8_t {
+        FLASH = 0,
+        EXPLOSION,
+        TRAIL,
+        KIND_COUNT
+    };
+
+    // Slots per kind, laid out in Kind order
+    explicit ParticlePool(
+        const std::array<std::size_t, KIND_COUNT>& capacities);
+
+    // Returns the slot used by the new particle
+    std::size_t spawn(Kind kind, float x, float y, float vx, float vy,
+        float life);
+
+    // Moves living particles, `expired` is called with the slot of every
+    // particle whose lifetime ran out during this step
+    void update(float dt, const std::function<void(std::size_t)>& expired);
+    void clear();
+
+    std::size_t capacity() const { return _life.size(); }
+    std::size_t alive() const { return _alive; }
+    bool isAlive(std::size_t slot) const { return _life[slot] > 0.0f; }
+    bool isMoving(std::size_t slot) const;
+
+    float x(std::size_t slot) const { return _x[slot]; }
+    float y(std::size_t slot) const { return _y[slot]; }
+    Kind kind(std::size_t slot) const { return _kind[slot]; }
+
+ private:
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _vx;
+    std::vector<float> _vy;
+    std::vector<float> _life;  // seconds left, <= 0 when the slot is free
+    std::vector<Kind> _kind;   // fixed at construction
+    std::vector<uint64_t> _born;  // spawn order, to recycle the oldest
+
+    std::array<std::size_t, KIND_COUNT + 1> _first = {};
+    std::array<std::vector<std::size_t>, KIND_COUNT> _free;
+    std::size_t _alive = 0;
+    uint64_t _spawned = 0;
+};
@@ -8,25 +8,41 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <cstdint>
 #include <vector>
 #include <chrono>
-#include <unordered_map>
+#include <deque>
+#include <optional>
 #include <GameTool.hpp>
+#include <clock.hpp>
 #include <network/GameClient.hpp>
 #include <event/events.hpp>
 #include <Game.hpp>
 #include <Protocol.hpp>
+#include <Snapshot.hpp>
+#include <Messages.hpp>
+#include <LinkStats.hpp>
+#include <FramePacer.hpp>
+#include <AssetPrefetcher.hpp>
+#include <ParticlePool.hpp>
+#include <ReliableChannel.hpp>
+#include <PacketCodec.hpp>
+#include <TimerWheel.hpp>
+#include <FrameArena.hpp>
 // #include <GameException.hpp>
 
 #define MENU_ID 0
 #define INGAME_ID 1
+#define ATLAS_DIR "./client/assets/atlas"  // cmake --build . --target atlas
 
 class RtypeClient : public Game {
  public:
+    // A spectator gets the match state but has no player and sends no input
     explicit RtypeClient(const std::string& protocol = "UDP",
-         uint16_t port = 5000, const std::string& server_ip = "127.0.0.1");
+         uint16_t port = 5000, const std::string& server_ip = "127.0.0.1",
+         bool spectator = false);
     ~RtypeClient();
 
     void run();
@@ -35,14 +51,31 @@ class RtypeClient : public Game {
     void sendWantStart();  // Envoyer WANT_START au serveur
     void sendShoot();
 
-    std::chrono::_V2::steady_clock::time_point getPing();
-    void setPing(std::chrono::_V2::steady_clock::time_point);
+    const LinkStats& getLinkStats() const { return _link; }
+    void setFrameRate(float fps) { _pacer.setRenderRate(fps); }
 
     void setECS(void);
     void setConfig(void);
     void setEntities(int scene);
 
-    #define FPS 60
+    #define FPS 60                  // render cap, 0 for uncapped
+    #define NETWORK_RATE 120        // network polls per second
+    #define INPUT_RATE 60           // input samples sent per second
+    #define PING_INTERVAL 1000      // milliseconds
+    #define RESYNC_DELAY 1.0f       // seconds between two RESYNC_REQUEST
+    #define HANDSHAKE_RETRY 0.5f    // seconds between two CONNECTION_REQUEST
+    #define HANDSHAKE_COOKIE_TRIES 20  // x RETRY = the server COOKIE_LIFETIME
+    #define FLASH_TIME 0.05f        // effect lifetimes, in seconds
+    #define EXPLOSION_TIME 0.3f
+    #define TRAIL_TIME 0.25f
+    #define TRAIL_DELAY 0.05f       // seconds between two trail particles
+    #define TRAIL_SPEED -300.0f
+    #define FLASH_EFFECTS 8         // EFFECTS slots per kind
+    #define EXPLOSION_EFFECTS 24
+    #define TRAIL_EFFECTS 32
+    #define EFFECT_PARKED -1000.0f  // off screen, where idle effects wait
+    #define PREDICTION_TIMEOUT 1.0f  // seconds, unconfirmed shots are dropped
+    #define WEAPON_SWITCH_DELAY 0.1f
 
     class TypeExtractError : public std::exception {
      public:
@@ -57,11 +90,53 @@ class RtypeClient : public Game {
 
  private:
     Weapons _weapon = MINIGUN;
+    // Cleared on use and set back by a _timers callback
+    std::array<bool, ENDWEAPON> _weaponReady = {true, true, true};
+    bool _switchReady = true;
+    TimerWheel _timers{1.0f / NETWORK_RATE};
+    // Transient buffers of the packet handlers, reset by update()
+    FrameArena _frame;
+    // Reused packet buffers: one for outgoing packets and one per nesting
+    // level of incoming ones (BUNDLE, then COMPRESSED), so an inner packet
+    // never overwrites the payload its container is still reading
+    std::vector<uint8_t> _outgoing;
+    std::vector<uint8_t> _unbundled;
+    std::vector<uint8_t> _inflated;
+    std::vector<uint8_t> _inflatedPayload;
 
     te::network::GameClient _client;
     uint16_t _server_port;
     std::string _server_ip;
-    std::chrono::_V2::steady_clock::time_point _pingTime;
+    bool _spectator;
+    LinkStats _link;
+    FramePacer _pacer{FPS, NETWORK_RATE, INPUT_RATE};
+    ReliableChannel _reliable;
+    PacketCodec _codec;
+    std::optional<uint64_t> _session_token;
+    uint64_t _cookie = 0;  // from CONNECTION_CHALLENGE, 0 until we get one
+    // Resends the handshake until it is answered, 0 once it is
+    TimerWheel::Id _handshakeTimer = 0;
+    size_t _handshakeTries = 0;  // with the current cookie
+    te::Timestamp _resyncTimer{RESYNC_DELAY};
+    AssetPrefetcher _prefetcher{ASSETS_DIR};
+    std::deque<std::string> _pendingConfigs;
+
+    // Cosmetic effects, drawn through the client-only EFFECTS field. Its
+    // entities are created once and then only moved or parked.
+    ParticlePool _effects{{FLASH_EFFECTS, EXPLOSION_EFFECTS, TRAIL_EFFECTS}};
+    te::Timestamp _trailTimer{TRAIL_DELAY};
+    std::chrono::steady_clock::time_point _effectsTick;
+
+    // Own shots spawned locally in the PREDICTED field until SHOT_CONFIRMED
+    struct PredictedShot {
+        uint16_t shot;
+        ShotEntities entities;
+        std::chrono::steady_clock::time_point fired;
+    };
+    uint16_t _nextShotId = 0;
+    size_t _nextPredicted = PREDICTED_BEGIN;
+    // Oldest first, a vector rather than a deque so it keeps its capacity
+    std::vector<PredictedShot> _predictedShots;
 
     uint32_t next_entity_id = 1;
     std::optional<uint32_t> _my_entity_id;
@@ -84,31 +159,64 @@ class RtypeClient : public Game {
     void runGame();   // Boucle de jeu principale (IN_GAME)
     void resetGameEntities();  // Reset entities after game end
 
+    // One pending config or one warm-up entity per call, between frames
+    void loadNextAsset();
+    void flushPendingConfigs();
+    void warmWave(size_t wave);
+
+    void spawnEffect(ParticlePool::Kind kind, float x, float y,
+        float vx = 0.0f, float vy = 0.0f);
+    void createEffects(void);
+    void updateEffects(void);
+    void clearEffects(void);
+
+    void expirePredictions(void);
+    void clearPredictions(void);
+
     void playersAnimation(void);
 
     void registerProtocolHandlers();
-
+    using Router = message::Router<RtypeClient>;
+    static const Router::Table& routes();
+    // Inner packets of BUNDLE, COMPRESSED and RELIABLE
+    void dispatch(uint8_t code, const std::vector<uint8_t>& data);
+
+    // CONNECTION_REQUEST, or SPECTATE, resent until answered
+    void startHandshake();
+    void retryHandshake();
+    void stopHandshake();
     void sendConnectionRequest();
+    void sendSpectate();
     void sendDisconnection();
-    void sendPong();
+    void sendPong(const std::vector<uint8_t>& ping);
+    void sendResyncRequest();
 
-    void handleConnectionAccepted(const std::vector<uint8_t>& data);
+    void handleChallenge(const ConnectionChallenge& msg);
+    void handleConnectionAccepted(const ConnectionAccepted& msg);
     void handleDisconnection(const std::vector<uint8_t>& data);
     void handleServerFull(const std::vector<uint8_t>& data);
     void handlePing(const std::vector<uint8_t>& data);
     void handlePong(const std::vector<uint8_t>& data);
     void handleEnnemiesData(const std::vector<uint8_t>& data);
+    // Snaps the ennemies to the rows and removes the absent ones
+    void syncEnnemies(const std::vector<uint8_t>& data, bool explode);
+    void handleEnnemiesUpdate(const std::vector<uint8_t>& data);
+    void handleEnnemiesRemoved(const std::vector<uint8_t>& data);
+    void applyEnnemyRows(const FrameVector<EnnemySnapshot>& rows);
+    // Explodes when still on screen, unless it is a resync
+    void removeEnnemy(size_t entity, bool explode = true);
     void handlePlayersData(const std::vector<uint8_t>& data);
     void handleProjectilesData(const std::vector<uint8_t>& data);
+    void handleShotConfirmed(const std::vector<uint8_t>& data);
+    void handleProjectilesRemoved(const std::vector<uint8_t>& data);
+    void handleCountdown(const CountdownStart& msg);
     void handleGameStarted(const std::vector<uint8_t>& data);
-    void handleGameEnded(const std::vector<uint8_t>& data);
-    void handleWaveSpawned(const std::vector<uint8_t>& data);
+    void handleGameEnded(const GameEnded& msg);
+    void handleWaveSpawned(const NewWave& msg);
+    void handleBundle(const std::vector<uint8_t>& data);
+    void handleReliable(const std::vector<uint8_t>& data);
+    void handleCompressed(const std::vector<uint8_t>& data);
+    void handleKeyframe(const std::vector<uint8_t>& data);
 
     std::string getPlayerTypeByEntityId(size_t entity_id) const;
-
-    void append(std::vector<uint8_t>& vec, uint32_t value) const;
-    uint32_t extractUint32(const std::vector<uint8_t>& data, size_t off) const;
-    size_t extractSizeT(const std::vector<uint8_t>& data, size_t off) const;
-    int64_t extractInt64(const std::vector<uint8_t>& data, size_t off) const;
-    float extractFloat(const std::vector<uint8_t>& data, size_t off) const;
 };
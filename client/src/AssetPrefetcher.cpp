@@ -0,0 +1,61 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** AssetPrefetcher.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include <Logger.hpp>
+#include <AssetPrefetcher.hpp>
+
+AssetPrefetcher::AssetPrefetcher(const std::string& dir)
+    : _reader(&AssetPrefetcher::readFiles, this, dir) {}
+
+AssetPrefetcher::~AssetPrefetcher() {
+    _stop = true;
+    if (_reader.joinable())
+        _reader.join();
+}
+
+void AssetPrefetcher::warm(const std::string& entity_name) {
+    if (_warmed.insert(entity_name).second)
+        _queue.push_back(entity_name);
+}
+
+std::optional<std::string> AssetPrefetcher::next() {
+    if (_queue.empty())
+        return std::nullopt;
+    std::string name = std::move(_queue.front());
+    _queue.pop_front();
+    return name;
+}
+
+void AssetPrefetcher::readFiles(const std::string& dir) {
+    std::array<char, 64 * 1024> buffer;
+    std::size_t files = 0;
+    std::size_t bytes = 0;
+    std::error_code ec;
+
+    for (const auto& entry :
+        std::filesystem::recursive_directory_iterator(dir, ec)) {
+        if (_stop)
+            break;
+        if (!entry.is_regular_file(ec))
+            continue;
+        std::ifstream file(entry.path(), std::ios::binary);
+        while (!_stop && file.read(buffer.data(), buffer.size()))
+            bytes += file.gcount();
+        bytes += file.gcount();
+        files++;
+    }
+    _files_done = true;
+    LOG_DEBUG("Assets", "Prefetched asset files",
+        {{"files", files}, {"bytes", bytes}});
+}
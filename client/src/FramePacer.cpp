@@ -0,0 +1,51 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** FramePacer.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <FramePacer.hpp>
+
+FramePacer::FramePacer(float render_hz, float network_hz, float input_hz) {
+    _render.setRate(render_hz);
+    _network.setRate(network_hz);
+    _input.setRate(input_hz);
+}
+
+void FramePacer::wait() {
+    if (_render.hz <= 0.0f || _network.hz <= 0.0f || _input.hz <= 0.0f)
+        return;
+    std::this_thread::sleep_until(
+        std::min({_render.next, _network.next, _input.next}));
+}
+
+float FramePacer::networkStep() const {
+    return _network.hz > 0.0f ? 1.0f / _network.hz : 0.0f;
+}
+
+void FramePacer::Rate::setRate(float rate) {
+    hz = rate;
+    period = rate > 0.0f
+        ? std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<float>(1.0f / rate))
+        : Clock::duration::zero();
+    next = Clock::now();
+}
+
+bool FramePacer::Rate::due(Clock::time_point now) {
+    if (hz <= 0.0f)
+        return true;
+    if (now < next)
+        return false;
+    next += period;
+    // Too late by more than a period: drop the missed ticks
+    if (next < now)
+        next = now + period;
+    return true;
+}
@@ -0,0 +1,88 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** ParticlePool.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+#include <functional>
+#include <ParticlePool.hpp>
+
+ParticlePool::ParticlePool(
+    const std::array<std::size_t, KIND_COUNT>& capacities) {
+    for (std::size_t k = 0; k < KIND_COUNT; ++k)
+        _first[k + 1] = _first[k] + capacities[k];
+    std::size_t capacity = _first[KIND_COUNT];
+
+    _x.resize(capacity);
+    _y.resize(capacity);
+    _vx.resize(capacity);
+    _vy.resize(capacity);
+    _life.resize(capacity, 0.0f);
+    _born.resize(capacity, 0);
+    _kind.resize(capacity);
+    for (std::size_t k = 0; k < KIND_COUNT; ++k) {
+        std::fill(_kind.begin() + _first[k], _kind.begin() + _first[k + 1],
+            static_cast<Kind>(k));
+        _free[k].reserve(capacities[k]);
+    }
+    clear();
+}
+
+std::size_t ParticlePool::spawn(Kind kind, float x, float y, float vx,
+    float vy, float life) {
+    std::vector<std::size_t>& free = _free[kind];
+    std::size_t slot;
+
+    if (!free.empty()) {
+        slot = free.back();
+        free.pop_back();
+        _alive++;
+    } else {
+        slot = std::min_element(_born.begin() + _first[kind],
+            _born.begin() + _first[kind + 1]) - _born.begin();
+    }
+    _x[slot] = x;
+    _y[slot] = y;
+    _vx[slot] = vx;
+    _vy[slot] = vy;
+    _life[slot] = life;
+    _born[slot] = ++_spawned;
+    return slot;
+}
+
+void ParticlePool::update(float dt,
+    const std::function<void(std::size_t)>& expired) {
+    std::size_t size = _life.size();
+
+    for (std::size_t i = 0; i < size; ++i) {
+        _x[i] += _vx[i] * dt;
+        _y[i] += _vy[i] * dt;
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+        if (_life[i] <= 0.0f)
+            continue;
+        _life[i] -= dt;
+        if (_life[i] > 0.0f)
+            continue;
+        _free[_kind[i]].push_back(i);
+        _alive--;
+        expired(i);
+    }
+}
+
+void ParticlePool::clear() {
+    std::fill(_life.begin(), _life.end(), 0.0f);
+    for (std::size_t k = 0; k < KIND_COUNT; ++k) {
+        _free[k].clear();
+        for (std::size_t i = _first[k + 1]; i > _first[k]; --i)
+            _free[k].push_back(i - 1);
+    }
+    _alive = 0;
+}
+
+bool ParticlePool::isMoving(std::size_t slot) const {
+    return _vx[slot] != 0.0f || _vy[slot] != 0.0f;
+}
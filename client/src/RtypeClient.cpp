@@ -12,15 +12,15 @@
 #include <chrono>
 #include <cstdint>
 #include <cstdio>
-#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <string>
 #include <csignal>
 #include <vector>
-#include <unordered_map>
 #include "ECS/Entity.hpp"
 #include "ECS/Zipper.hpp"
 #include "Game.hpp"
+#include "waves.hpp"
 #include "clock.hpp"
 #include "physic/components/velocity.hpp"
 #include <physic/components/position.hpp>
@@ -28,24 +28,32 @@
 #include <entity_spec/components/health.hpp>
 #include <event/events.hpp>
 #include <RtypeClient.hpp>
+#include <PacketBundle.hpp>
+#include <Snapshot.hpp>
+#include <Logger.hpp>
 #include <GameTool.hpp>
 
 RtypeClient::RtypeClient(const std::string& protocol, uint16_t port,
-    const std::string& server_ip)
+    const std::string& server_ip, bool spectator)
     : Game("./client/plugins")
     , _client(protocol)
     , _server_port(port)
-    , _server_ip(server_ip) {
+    , _server_ip(server_ip)
+    , _spectator(spectator) {
     registerProtocolHandlers();
+    _predictedShots.reserve(PREDICTED_FIELD_SIZE);
+    // Must be the server's file, packets compressed with it fail without
+    _codec.loadDictionary();
     _client.setConnectCallback([this]() {
-        std::cout
-        << "[Client] Network connection established, "
-        << "sending CONNECTION_REQUEST...\n";
-        sendConnectionRequest();
+        LOG_INFO("Client", _spectator
+            ? "Network connection established, sending SPECTATE"
+            : "Network connection established, sending CONNECTION_REQUEST");
+        startHandshake();
     });
 
     _client.setDisconnectCallback([this]() {
-        std::cout << "[Client] Disconnected from server\n";
+        LOG_WARN("Client", "Disconnected from server");
+        stopHandshake();
         // TODO(Pierre): Cleanup local entities, return to menu, etc.
     });
 }
@@ -63,29 +71,181 @@ void RtypeClient::setECS(void) {
     createSystem("display");
 }
 
+// Sprite config rewritten by r-type_atlas, when the atlas was built
+static std::string spriteConfig(const std::string& path) {
+    std::filesystem::path packed = std::filesystem::path(ATLAS_DIR)
+        / std::filesystem::path(path).filename();
+
+    return std::filesystem::exists(packed) ? packed.string() : path;
+}
+
 void RtypeClient::setConfig(void) {
-    // MENU
+    // MENU, needed for the first frame
     addConfig("./client/assets/menu/menu.toml");
     addConfig("./client/assets/buttons/buttonstart.toml");
     addConfig("./client/assets/buttons/buttonquit.toml");
 
-    // MAP
-    addConfig("./client/assets/background/config.toml");
-    addConfig("./config/entities/boundaries.toml");
+    // Everything else is loaded one config per frame while in the lobby
+    _pendingConfigs = {
+        // MAP
+        "./client/assets/background/config.toml",
+        "./config/entities/boundaries.toml",
+
+        // PLAYER
+        "./config/entities/player.toml",
+        spriteConfig("./client/assets/player/player.toml"),
+
+        // MOBS
+        "./config/entities/enemy1.toml",
+        spriteConfig("./client/assets/enemies/basic/enemy1.toml"),
+        "./config/entities/enemy2.toml",
+        spriteConfig("./client/assets/enemies/basic/enemy2.toml"),
+        "./config/entities/enemy3.toml",
+        spriteConfig("./client/assets/enemies/basic/enemy3.toml"),
+        "./config/entities/enemy4.toml",
+        spriteConfig("./client/assets/enemies/basic/enemy4.toml"),
+    };
+}
 
-    // PLAYER
-    addConfig("./config/entities/player.toml");
-    addConfig("./client/assets/player/player.toml");
+void RtypeClient::loadNextAsset() {
+    if (!_pendingConfigs.empty()) {
+        addConfig(_pendingConfigs.front());
+        _pendingConfigs.pop_front();
+        if (!_pendingConfigs.empty())
+            return;
 
-    // MOBS
-    addConfig("./config/entities/enemy1.toml");
-    addConfig("./client/assets/enemies/basic/enemy1.toml");
-    addConfig("./config/entities/enemy2.toml");
-    addConfig("./client/assets/enemies/basic/enemy2.toml");
-    addConfig("./config/entities/enemy3.toml");
-    addConfig("./client/assets/enemies/basic/enemy3.toml");
-    addConfig("./config/entities/enemy4.toml");
-    addConfig("./client/assets/enemies/basic/enemy4.toml");
+        for (const char* name : {"bg1", "bg2", "bg3", "bg4", "bg5", "bg6",
+            "player1", "player2", "player3", "player4"})
+            _prefetcher.warm(name);
+        for (const auto& [weapon, name] : WEAPONS_NAMES)
+            _prefetcher.warm(name);
+        warmWave(0);
+        createEffects();
+        LOG_DEBUG("Client", "Gameplay configs loaded");
+        return;
+    }
+
+    auto name = _prefetcher.next();
+    if (!name.has_value())
+        return;
+    createEntity(EntityField::WARMUP, name.value());
+    removeEntity(EntityField::WARMUP);
+}
+
+void RtypeClient::flushPendingConfigs() {
+    while (!_pendingConfigs.empty())
+        loadNextAsset();
+}
+
+void RtypeClient::warmWave(size_t wave) {
+    if (wave >= WAVES.size())
+        return;
+    for (const auto& entity : WAVES[wave])
+        _prefetcher.warm(entity.name);
+}
+
+// Seconds between two shots, indexed by Weapons
+static const std::array<float, Game::ENDWEAPON> WEAPON_COOLDOWNS = {
+    0.08f, 2.0f, 1.2f};
+
+static_assert(FLASH_EFFECTS + EXPLOSION_EFFECTS + TRAIL_EFFECTS
+    == EFFECTS_FIELD_SIZE);
+
+static const std::array<const char*, ParticlePool::KIND_COUNT>
+    EFFECT_NAMES = {"flash", "explosion", "trail"};
+
+// Entity of an effect slot, nullptr before createEffects()
+template <typename Positions>
+static addon::physic::Position2* effectPosition(Positions& positions,
+    size_t slot) {
+    size_t e = EntityField::EFFECTS_BEGIN + slot;
+
+    if (e >= positions.size() || !positions[e].has_value())
+        return nullptr;
+    return &positions[e].value();
+}
+
+void RtypeClient::createEffects(void) {
+    for (size_t slot = 0; slot < _effects.capacity(); ++slot)
+        createEntity(EntityField::EFFECTS_BEGIN + slot,
+            EFFECT_NAMES[_effects.kind(slot)],
+            {EFFECT_PARKED, EFFECT_PARKED});
+}
+
+void RtypeClient::spawnEffect(ParticlePool::Kind kind, float x, float y,
+    float vx, float vy) {
+    static const std::array<float, ParticlePool::KIND_COUNT> lifetimes = {
+        FLASH_TIME, EXPLOSION_TIME, TRAIL_TIME};
+    size_t slot = _effects.spawn(kind, x, y, vx, vy, lifetimes[kind]);
+    auto* pos = effectPosition(getComponent<addon::physic::Position2>(),
+        slot);
+
+    if (pos != nullptr) {
+        pos->x = x;
+        pos->y = y;
+    }
+}
+
+void RtypeClient::updateEffects(void) {
+    auto now = std::chrono::steady_clock::now();
+    float dt = std::chrono::duration<float>(now - _effectsTick).count();
+    _effectsTick = now;
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto& velocities = getComponent<addon::physic::Velocity2>();
+
+    if (_trailTimer.checkDelay()) {
+        for (size_t e = EntityField::PLAYER_BEGIN;
+            e < EntityField::PLAYER_END && e < velocities.size(); ++e) {
+            if (!velocities[e].has_value() || !positions[e].has_value())
+                continue;
+            spawnEffect(ParticlePool::TRAIL, positions[e].value().x,
+                positions[e].value().y + 25, TRAIL_SPEED);
+        }
+    }
+
+    // Stale ticks (first frame of a match) would teleport the particles
+    _effects.update(std::min(dt, 0.1f), [&positions](size_t slot) {
+        if (auto* pos = effectPosition(positions, slot))
+            pos->x = EFFECT_PARKED;
+    });
+    for (size_t slot = 0; slot < _effects.capacity(); ++slot) {
+        if (!_effects.isAlive(slot) || !_effects.isMoving(slot))
+            continue;
+        if (auto* pos = effectPosition(positions, slot)) {
+            pos->x = _effects.x(slot);
+            pos->y = _effects.y(slot);
+        }
+    }
+}
+
+void RtypeClient::clearEffects(void) {
+    auto& positions = getComponent<addon::physic::Position2>();
+
+    _effects.clear();
+    for (size_t slot = 0; slot < _effects.capacity(); ++slot)
+        if (auto* pos = effectPosition(positions, slot))
+            pos->x = EFFECT_PARKED;
+}
+
+void RtypeClient::expirePredictions(void) {
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto now = std::chrono::steady_clock::now();
+    auto expired = _predictedShots.begin();
+
+    while (expired != _predictedShots.end() && now - expired->fired
+        >= std::chrono::duration<float>(PREDICTION_TIMEOUT)) {
+        for (ECS::Entity e : expired->entities)
+            if (e < positions.size() && positions[e].has_value())
+                removeEntity(e);
+        expired++;
+    }
+    _predictedShots.erase(_predictedShots.begin(), expired);
+}
+
+void RtypeClient::clearPredictions(void) {
+    _predictedShots.clear();
+    _nextPredicted = EntityField::PREDICTED_BEGIN;
+    clearField(EntityField::PREDICTED_BEGIN, EntityField::PREDICTED_END);
 }
 
 void RtypeClient::setEntities(int scene) {
@@ -111,22 +271,21 @@ void signalHandler(int signal) {
 }
 
 void RtypeClient::run() {
-    std::cout << "=== R-Type Client ===\n";
-    std::cout << "Server: " << _server_ip << ":" << _server_port << "\n";
-    std::cout << "=====================\n";
+    LOG_INFO("Client", "R-Type Client",
+        {{"server", _server_ip}, {"port", _server_port}});
 
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
 
     try {
-        std::cout << "[Client] Connecting to server...\n";
+        LOG_INFO("Client", "Connecting to server...");
         if (!connect(_server_ip, _server_port)) {
-            std::cerr << "[Client] Failed to connect to server\n";
+            LOG_ERROR("Client", "Failed to connect to server");
             return;
         }
 
-        std::cout << "[Client] Connected! Waiting for game to start...\n";
-        std::cout << "[Client] Press Ctrl+C to disconnect\n";
+        LOG_INFO("Client", "Connected, waiting for game to start"
+            " (Ctrl+C to disconnect)");
 
         setECS();
         setConfig();
@@ -141,75 +300,65 @@ void RtypeClient::run() {
                     runGame();
                 }
             } else if (getGameState() == GAME_ENDED) {
-                std::cout << "[Client] Game ended!\n";
-                break;
+                LOG_INFO("Client", "Game ended, back to lobby");
+                resetGameEntities();
+                setEntities(MENU_ID);
+                setGameState(GAME_WAITING);
             }
         }
 
         if (isConnected()) {
-            std::cout << "[Client] Disconnecting...\n";
+            LOG_INFO("Client", "Disconnecting...");
             disconnect();
         }
-        std::cout << "[Client] Goodbye!\n";
+        LOG_INFO("Client", "Goodbye!");
     } catch (const std::exception& e) {
-        std::cerr << "[Client] Fatal error: " << e.what() << "\n";
+        LOG_ERROR("Client", "Fatal error", {{"what", e.what()}});
         return;
     }
 }
 
 void RtypeClient::waitGame() {
-    const float deltaTime = 1.0f / FPS;
-    auto lastUpdate = std::chrono::steady_clock::now();
     auto lastPing = std::chrono::steady_clock::now();
 
     while (!isEvent(te::event::System::Closed) && isConnected()
            && getGameState() == GAME_WAITING) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed =
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - lastUpdate).count();
-
-        if (elapsed >= (1000.0f / FPS)) {
-            update(deltaTime);
-            lastUpdate = now;
-        }
-
-        // Send ping every 5 seconds
-        auto pingElapsed =
-            std::chrono::duration_cast<std::chrono::seconds>(
-            now - lastPing).count();
-        if (pingElapsed >= 5) {
-            std::cout << "[Client] Sending PING...\n";
-            sendPing();
-            lastPing = now;
+        _pacer.wait();
+
+        if (_pacer.networkDue()) {
+            update(_pacer.networkStep());
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastPing >= std::chrono::milliseconds(PING_INTERVAL)) {
+                sendPing();
+                lastPing = now;
+            }
         }
 
-        pollEvent();
-        auto events = getEvents();
-
-        if (isEvent(te::event::System::ChangeScene)) {
-            std::cout
-                << "[Client] P pressed - Sending WANT_START (test mode)\n";
-            for (int i = static_cast<int>(MENU_BEGIN);
-            i <= static_cast<int>(MENU_BEGIN + 2); i++) {
-                removeEntity(i);
+        if (_pacer.inputDue()) {
+            pollEvent();
+            if (isEvent(te::event::System::ChangeScene)) {
+                LOG_DEBUG("Client", "P pressed, sending WANT_START");
+                for (int i = static_cast<int>(MENU_BEGIN);
+                i <= static_cast<int>(MENU_BEGIN + 2); i++) {
+                    removeEntity(i);
+                }
+                sendWantStart();
+                setSystemEvent(te::event::System::ChangeScene, false);
             }
-            sendWantStart();
-            setSystemEvent(te::event::System::ChangeScene, false);
         }
 
-        emit();
-
-        runSystems();
+        if (_pacer.renderDue()) {
+            loadNextAsset();
+            emit();
+            runSystems();
+        }
     }
 }
 
 void RtypeClient::runGame() {
-    const float deltaTime = 1.0f / FPS;
-    static te::Timestamp weapon_switch(0.1f);
-    auto lastUpdate = std::chrono::steady_clock::now();
     auto lastPing = std::chrono::steady_clock::now();
 
+    flushPendingConfigs();
     createEntity(_nextMap++, "bg1");
     createEntity(_nextMap++, "bg2");
     createEntity(_nextMap++, "bg3");
@@ -220,46 +369,46 @@ void RtypeClient::runGame() {
 
     while (!isEvent(te::event::System::Closed) && isConnected()
            && getGameState() == IN_GAME) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed =
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - lastUpdate).count();
-
-        if (elapsed >= (1000.0f / FPS)) {
-            update(deltaTime);
-            lastUpdate = now;
-        }
-
-        // Send ping every 5 seconds
-        auto pingElapsed =
-            std::chrono::duration_cast<std::chrono::seconds>(
-            now - lastPing).count();
-        if (pingElapsed >= 5) {
-            std::cout << "[Client] Sending PING...\n";
-            sendPing();
-            lastPing = now;
+        _pacer.wait();
+
+        if (_pacer.networkDue()) {
+            update(_pacer.networkStep());
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastPing >= std::chrono::milliseconds(PING_INTERVAL)) {
+                sendPing();
+                lastPing = now;
+            }
         }
 
-        pollEvent();
-        auto events = getEvents();
-        sendEvent(events);
+        if (_pacer.inputDue()) {
+            pollEvent();
+            auto events = getEvents();
+            sendEvent(events);
+
+            if (events.keys.UniversalKey[te::event::Key::R]
+                && _switchReady) {
+                _weapon = static_cast<Weapons>(_weapon + 1);
+                if (_weapon >= Weapons::ENDWEAPON)
+                    _weapon = MINIGUN;
+                _switchReady = false;
+                _timers.after(WEAPON_SWITCH_DELAY,
+                    [this]() { _switchReady = true; });
+            }
 
-        if (events.keys.UniversalKey[te::event::Key::R]
-            && weapon_switch.checkDelay()) {
-            _weapon = static_cast<Weapons>(_weapon + 1);
-            if (_weapon >= Weapons::ENDWEAPON)
-                _weapon = MINIGUN;
+            if (events.keys.UniversalKey[te::event::Space])
+                sendShoot();
         }
 
-        if (events.keys.UniversalKey[te::event::Space])
-            sendShoot();
-
-        if (_my_entity_id.has_value()) {
-            emit(_my_entity_id);
+        if (_pacer.renderDue()) {
+            if (_my_entity_id.has_value()) {
+                emit(_my_entity_id);
+            }
+            loadNextAsset();
+            updateEffects();
+            expirePredictions();
+            playersAnimation();
+            runSystems();
         }
-        playersAnimation();
-
-        runSystems();
     }
 }
 
@@ -278,92 +427,61 @@ void RtypeClient::playersAnimation(void) {
 }
 
 void RtypeClient::resetGameEntities() {
-    std::cout << "[Client] Cleaning up game entities...\n";
-
-    for (ECS::Entity e = EntityField::ENEMIES_BEGIN;
-         e < EntityField::ENEMIES_END; ++e) {
-        removeEntity(e);
-    }
-
-    for (ECS::Entity e = EntityField::PROJECTILES_BEGIN;
-         e < EntityField::PROJECTILES_END; ++e) {
-        removeEntity(e);
-    }
-
-    for (ECS::Entity e = EntityField::MAP_BEGIN;
-         e < EntityField::MAP_END; ++e) {
-        removeEntity(e);
-    }
-
-    for (ECS::Entity e = EntityField::PLAYER_BEGIN;
-         e < EntityField::PLAYER_END; ++e) {
-        removeEntity(e);
-    }
+    size_t removed = clearMatchFields();
+    clearEffects();
+    clearPredictions();
 
     _nextMap = EntityField::MAP_BEGIN;
     _nextEnnemy = EntityField::ENEMIES_BEGIN;
     _nextProjectile = EntityField::PROJECTILES_BEGIN;
     _nextPlayer = EntityField::PLAYER_BEGIN;
 
-    std::cout << "[Client] Game entities cleaned up!\n";
-}
-
-std::chrono::_V2::steady_clock::time_point RtypeClient::getPing() {
-    return _pingTime;
-}
-
-void RtypeClient::setPing(std::chrono::_V2::steady_clock::time_point time) {
-    _pingTime = time;
+    LOG_INFO("Client", "Game entities cleaned up", {{"removed", removed}});
 }
 
 void RtypeClient::sendEvent(te::event::Events events) {
-    if (!isConnected()) {
+    if (!isConnected() || _spectator) {
         return;
     }
 
-    std::vector<uint8_t> packet;
-
-    packet.push_back(CLIENT_EVENT);
+    // The engine serializer returns a fresh vector, only ours is reused
     std::vector<uint8_t> temp = net::PacketSerializer::serialize(events);
-    std::copy(temp.begin(), temp.end(), back_inserter(packet));
-    _client.send(packet);
+    _outgoing.assign(1, CLIENT_EVENT);
+    _outgoing.insert(_outgoing.end(), temp.begin(), temp.end());
+    _client.send(_outgoing);
 }
 
 void RtypeClient::sendShoot() {
-    static te::Timestamp delay[3] = {
-        te::Timestamp(0.08f),
-        te::Timestamp(2.0f),
-        te::Timestamp(1.2f)};
-    static bool first_shot = true;
-
-    if (!isConnected()) {
+    if (!isConnected() || _spectator) {
         return;
     }
 
-    if (!first_shot && !delay[_weapon].checkDelay()) {
+    if (!_weaponReady[_weapon]) {
         return;
     }
+    Weapons weapon = _weapon;
+    _weaponReady[weapon] = false;
+    _timers.after(WEAPON_COOLDOWNS[weapon],
+        [this, weapon]() { _weaponReady[weapon] = true; });
 
+    uint16_t shot = _nextShotId++;
     if (_my_entity_id.has_value()) {
         auto& position = getComponent<addon::physic::Position2>();
-        if (position[_my_entity_id.value()].has_value()) {
-            createEntity(PROJECTILES_END + 1, "flash",
-                {position[_my_entity_id.value()].value().x + 70,
-                position[_my_entity_id.value()].value().y + 10});
+        size_t me = _my_entity_id.value();
+        if (me < position.size() && position[me].has_value()) {
+            mat::Vector2f origin = {position[me].value().x,
+                position[me].value().y};
+            spawnEffect(ParticlePool::FLASH, origin.x + 70, origin.y + 10);
+            _predictedShots.push_back({shot,
+                createShot(weapon, me, shot, origin, _nextPredicted,
+                    EntityField::PREDICTED_BEGIN, EntityField::PREDICTED_END),
+                std::chrono::steady_clock::now()});
         }
     }
 
-    if (first_shot) {
-        first_shot = false;
-        delay[_weapon].restart();
-    }
-
-    // TODO(PIERRE): delay
-    std::vector<uint8_t> packet;
-
-    packet.push_back(PLAYER_SHOT);
-    packet.push_back(static_cast<uint8_t>(_weapon));
-    _client.send(packet);
+    message::encode(PlayerShot{static_cast<uint8_t>(weapon), shot},
+        _outgoing);
+    _client.send(_outgoing);
 }
 
 bool RtypeClient::connect(const std::string& ip, uint16_t port) {
@@ -371,6 +489,7 @@ bool RtypeClient::connect(const std::string& ip, uint16_t port) {
 }
 
 void RtypeClient::disconnect() {
+    stopHandshake();
     if (_client.isConnected()) {
         sendDisconnection();
     }
@@ -378,309 +497,365 @@ void RtypeClient::disconnect() {
 }
 
 void RtypeClient::update(float delta_time) {
+    _frame.reset();
     _client.update(delta_time);
+    _timers.advance();
 }
 
-void RtypeClient::registerProtocolHandlers() {
-    _client.registerPacketHandler(CONNECTION_ACCEPTED,
-        [this](const std::vector<uint8_t>& data) {
-            handleConnectionAccepted(data);
-        });
-
-    _client.registerPacketHandler(DISCONNECTION,
-        [this](const std::vector<uint8_t>& data) {
-            handleDisconnection(data);
-        });
-
-    _client.registerPacketHandler(ERROR_TOO_MANY_CLIENTS,
-        [this](const std::vector<uint8_t>& data) {
-            handleServerFull(data);
-        });
-
-    _client.registerPacketHandler(PING,
-        [this](const std::vector<uint8_t>& data) {
-            handlePing(data);
-        });
-
-    _client.registerPacketHandler(PONG,
-        [this](const std::vector<uint8_t>& data) {
-            handlePong(data);
-        });
-
-    _client.registerPacketHandler(PLAYERS_DATA,
-        [this](const std::vector<uint8_t>& data) {
-            handlePlayersData(data);
-        });
+const RtypeClient::Router::Table& RtypeClient::routes() {
+    static constexpr Router::Table ROUTES = Router::table({
+        Router::typed<ConnectionChallenge, &RtypeClient::handleChallenge>(),
+        Router::typed<ConnectionAccepted,
+            &RtypeClient::handleConnectionAccepted>(),
+        Router::raw<&RtypeClient::handleDisconnection>(DISCONNECTION),
+        Router::raw<&RtypeClient::handleServerFull>(ERROR_TOO_MANY_CLIENTS),
+        Router::raw<&RtypeClient::handlePing>(PING),
+        Router::raw<&RtypeClient::handlePong>(PONG),
+        Router::raw<&RtypeClient::handlePlayersData>(PLAYERS_DATA),
+        Router::raw<&RtypeClient::handleProjectilesData>(PROJECTILES_DATA),
+        Router::raw<&RtypeClient::handleShotConfirmed>(SHOT_CONFIRMED),
+        Router::raw<&RtypeClient::handleProjectilesRemoved>(
+            PROJECTILES_REMOVED),
+        Router::raw<&RtypeClient::handleEnnemiesUpdate>(ENNEMIES_UPDATE),
+        Router::raw<&RtypeClient::handleEnnemiesRemoved>(ENNEMIES_REMOVED),
+        Router::raw<&RtypeClient::handleEnnemiesData>(ENNEMIES_DATA),
+        Router::typed<CountdownStart, &RtypeClient::handleCountdown>(),
+        Router::raw<&RtypeClient::handleGameStarted>(GAME_START),
+        Router::typed<GameEnded, &RtypeClient::handleGameEnded>(),
+        Router::typed<NewWave, &RtypeClient::handleWaveSpawned>(),
+        Router::raw<&RtypeClient::handleBundle>(BUNDLE),
+        Router::raw<&RtypeClient::handleCompressed>(COMPRESSED),
+        Router::raw<&RtypeClient::handleReliable>(RELIABLE),
+        Router::raw<&RtypeClient::handleKeyframe>(KEYFRAME),
+    });
+    return ROUTES;
+}
 
-    _client.registerPacketHandler(PROJECTILES_DATA,
-        [this](const std::vector<uint8_t>& data) {
-            handleProjectilesData(data);
-        });
+void RtypeClient::registerProtocolHandlers() {
+    for (size_t code = 0; code < routes().size(); ++code) {
+        if (routes()[code] == nullptr)
+            continue;
+        _client.registerPacketHandler(static_cast<uint8_t>(code),
+            [this, code](const std::vector<uint8_t>& data) {
+                routes()[code](*this, data);
+            });
+    }
+}
 
-    _client.registerPacketHandler(ENNEMIES_DATA,
-        [this](const std::vector<uint8_t>& data) {
-            handleEnnemiesData(data);
-        });
+void RtypeClient::dispatch(uint8_t code, const std::vector<uint8_t>& data) {
+    if (routes()[code] != nullptr)
+        routes()[code](*this, data);
+}
 
-    _client.registerPacketHandler(GAME_START,
-        [this](const std::vector<uint8_t>& data) {
-            handleGameStarted(data);
-        });
+void RtypeClient::startHandshake() {
+    _reliable.reset();
+    _cookie = 0;
+    _handshakeTries = 0;
+    _timers.cancel(_handshakeTimer);
+    _handshakeTimer = _timers.every(HANDSHAKE_RETRY,
+        [this]() { retryHandshake(); });
+    if (_spectator)
+        sendSpectate();
+    else
+        sendConnectionRequest();
+}
 
-    _client.registerPacketHandler(GAME_ENDED,
-        [this](const std::vector<uint8_t>& data) {
-            handleGameEnded(data);
-        });
+void RtypeClient::retryHandshake() {
+    // Lost CHALLENGE or lost request, the cookie may have expired since
+    if (++_handshakeTries > HANDSHAKE_COOKIE_TRIES) {
+        _cookie = 0;
+        _handshakeTries = 0;
+    }
+    if (_spectator)
+        sendSpectate();
+    else
+        sendConnectionRequest();
+}
 
-    _client.registerPacketHandler(NEW_WAVE,
-        [this](const std::vector<uint8_t>& data) {
-            handleWaveSpawned(data);
-        });
+void RtypeClient::stopHandshake() {
+    _timers.cancel(_handshakeTimer);
+    _handshakeTimer = 0;
 }
 
 void RtypeClient::sendConnectionRequest() {
-    std::vector<uint8_t> packet;
+    message::encode(ConnectionRequest{_cookie, _session_token.value_or(0)},
+        _outgoing);
+    _client.send(_outgoing);
+}
 
-    packet.push_back(CONNECTION_REQUEST);
-    _client.send(packet);
+void RtypeClient::sendSpectate() {
+    message::encode(Spectate{_cookie}, _outgoing);
+    _client.send(_outgoing);
 }
 
-void RtypeClient::sendDisconnection() {
-    std::vector<uint8_t> packet;
+void RtypeClient::sendResyncRequest() {
+    if (!_resyncTimer.checkDelay())
+        return;
+    LOG_INFO("Client", "Missed some state, asking for a keyframe");
+    _outgoing.assign(1, RESYNC_REQUEST);
+    _client.send(_outgoing);
+}
 
-    packet.push_back(DISCONNECTION);
-    _client.send(packet);
+void RtypeClient::sendDisconnection() {
+    _outgoing.assign(1, DISCONNECTION);
+    _client.send(_outgoing);
 }
 
 void RtypeClient::sendPing() {
-    std::vector<uint8_t> packet;
-
-    setPing(std::chrono::steady_clock::now());
-    packet.push_back(PING);
-    _client.send(packet);
+    _link.checkTimeouts();
+    _link.makePing(_outgoing);
+    _client.send(_outgoing);
 }
 
-void RtypeClient::sendPong() {
-    std::vector<uint8_t> packet;
-
-    packet.push_back(PONG);
-    _client.send(packet);
+void RtypeClient::sendPong(const std::vector<uint8_t>& ping) {
+    LinkStats::makePong(ping, _outgoing);
+    _client.send(_outgoing);
 }
 
 void RtypeClient::sendWantStart() {
+    if (_spectator)
+        return;
     if (!isConnected()) {
-        std::cerr << "[Client] Cannot send WANT_START: not connected\n";
+        LOG_WARN("Client", "Cannot send WANT_START: not connected");
         return;
     }
 
-    std::vector<uint8_t> packet;
-    packet.push_back(WANT_START);
+    _outgoing.assign(1, WANT_START);
 
-    std::cout << "[Client] Sending WANT_START to server\n";
-    _client.send(packet);
+    LOG_INFO("Client", "Sending WANT_START to server");
+    _client.send(_outgoing);
 }
 
-void RtypeClient::handleConnectionAccepted(const std::vector<uint8_t>& data) {
-    if (data.size() < 4) {
-        std::cerr << "[Client] Invalid CONNECTION_ACCEPTED packet size\n";
+void RtypeClient::handleChallenge(const ConnectionChallenge& msg) {
+    if (_handshakeTimer == 0)
         return;
-    }
+    // Same request again, this time proving we own our address
+    _cookie = msg.cookie;
+    _handshakeTries = 0;
+    if (_spectator)
+        sendSpectate();
+    else
+        sendConnectionRequest();
+}
 
-    size_t entity_id = extractSizeT(data, 0);
+void RtypeClient::handleConnectionAccepted(const ConnectionAccepted& msg) {
+    // The server answers a duplicated request again, nothing changed
+    if (_handshakeTimer == 0 && _my_entity_id == msg.entity &&
+        _session_token == msg.token)
+        return;
+    stopHandshake();
+    size_t entity_id = msg.entity;
+    bool reclaimed = _session_token == msg.token;
     _nextPlayer++;
     _my_entity_id = entity_id;
+    _session_token = msg.token;
 
-    std::cout << "[Client] Connection accepted! Our server entity ID: "
-        << entity_id << "\n";
+    LOG_INFO("Client", "Connection accepted", {{"entity", entity_id},
+        {"reclaimed", reclaimed}});
 
-    // Mettre le jeu en mode attente
-    setGameState(GAME_WAITING);
-    std::cout << "[Client] Waiting for players to be ready...\n";
+    // Mettre le jeu en mode attente, sauf reprise de partie (KEYFRAME suit)
+    if (!reclaimed)
+        setGameState(GAME_WAITING);
+}
+
+void RtypeClient::handleKeyframe(const std::vector<uint8_t>& data) {
+    Keyframe frame;
+    if (!snapshot::read(data, frame)) {
+        LOG_WARN("Client", "Invalid KEYFRAME packet", {{"size", data.size()}});
+        return;
+    }
+    // The answer to SPECTATE
+    if (_spectator)
+        stopHandshake();
+
+    if (frame.state != IN_GAME) {
+        if (getGameState() == IN_GAME)
+            setGameState(GAME_ENDED);
+        return;
+    }
+
+    flushPendingConfigs();
+    clearEffects();
+    clearPredictions();
+    clearField(EntityField::MENU_BEGIN, EntityField::MENU_END);
+    clearField(EntityField::PLAYER_BEGIN, EntityField::PLAYER_END);
+    clearField(EntityField::ENEMIES_BEGIN, EntityField::ENEMIES_END);
+    clearField(EntityField::PROJECTILES_BEGIN, EntityField::PROJECTILES_END);
+    _nextPlayer = EntityField::PLAYER_BEGIN;
+    _nextProjectile = EntityField::PROJECTILES_BEGIN;
+    _nextEnnemy = EntityField::ENEMIES_BEGIN;
+    for (uint32_t wave = 0; wave < frame.waves; ++wave)
+        _nextEnnemy = createMobWave(wave, _nextEnnemy,
+            EntityField::ENEMIES_END);
+
+    setGameState(IN_GAME);
+    handlePlayersData(frame.players);
+    // The wave replay recreated dead ennemies too, they go silently
+    syncEnnemies(frame.ennemies, false);
+    handleProjectilesData(frame.projectiles);
+    LOG_INFO("Client", "Resynced from keyframe", {{"waves", frame.waves},
+        {"bytes", data.size()}});
 }
 
 void RtypeClient::handleDisconnection(const std::vector<uint8_t>& data) {
-    std::cout << "[Client] Server disconnected us\n";
+    LOG_WARN("Client", "Server disconnected us");
 }
 
 void RtypeClient::handleServerFull(const std::vector<uint8_t>& data) {
-    std::cout << "[Client] Server full!\n";
+    LOG_WARN("Client", "Server full");
     disconnect();  // TODO(PIERRE): On pourrait le laisser attendre
     // ouais why not, on le deco si il fait rien trop longtemps
 }
 
 void RtypeClient::handlePing(const std::vector<uint8_t>& data) {
-    std::cout << "[Client] Ping received, sending pong...\n";
-    sendPong();
+    sendPong(data);
 }
 
 void RtypeClient::handlePong(const std::vector<uint8_t>& data) {
-    std::cout << "[Client] Pong received\n";
-    auto now = std::chrono::steady_clock::now();
-    auto pingElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - getPing()).count();
-    std::cout << "Latency between sendPing and receive Pong (in ms): "
-        << pingElapsed << "\n";
-}
-
-void RtypeClient::append(std::vector<uint8_t>& vec, uint32_t value) const {
-    std::array<uint8_t, 4> bytes;
-    std::memcpy(bytes.data(), &value, 4);
-    vec.insert(vec.end(), bytes.begin(), bytes.end());
+    _link.onPong(data);
 }
 
-float RtypeClient::extractFloat(const std::vector<uint8_t>& data,
-    size_t offset) const {
-    if (offset + sizeof(float) > data.size())
-        throw TypeExtractError("Could not extract float at pos " + offset);
-    float value;
-    std::memcpy(&value, data.data() + offset, sizeof(float));
-    return value;
+void RtypeClient::handleEnnemiesData(const std::vector<uint8_t>& data) {
+    syncEnnemies(data, true);
 }
 
-uint32_t RtypeClient::extractUint32(const std::vector<uint8_t>& data,
-    size_t offset) const {
-    if (offset + sizeof(uint32_t) > data.size())
-        throw TypeExtractError("Could not extract uint32_t at pos " + offset);
-    uint32_t value;
-    std::memcpy(&value, data.data() + offset, sizeof(uint32_t));
-    return value;
-}
+void RtypeClient::syncEnnemies(const std::vector<uint8_t>& data,
+    bool explode) {
+    if (data.empty() || getGameState() != IN_GAME)
+        return;
+    FrameVector<EnnemySnapshot> rows(_frame);
+    if (!snapshot::read(data, rows))
+        LOG_WARN("Client", "Truncated ENNEMIES_DATA", {{"size", data.size()}});
+
+    FrameVector<bool> present(
+        EntityField::ENEMIES_END - EntityField::ENEMIES_BEGIN, false, _frame);
+    for (const auto& row : rows)
+        if (row.entity >= EntityField::ENEMIES_BEGIN &&
+            row.entity < EntityField::ENEMIES_END)
+            present[row.entity - EntityField::ENEMIES_BEGIN] = true;
+    applyEnnemyRows(rows);
 
-size_t RtypeClient::extractSizeT(const std::vector<uint8_t>& data,
-    size_t offset) const {
-    if (offset + sizeof(size_t) > data.size())
-        throw TypeExtractError("Could not extract size_t at pos " + offset);
-    size_t value;
-    std::memcpy(&value, data.data() + offset, sizeof(size_t));
-    return value;
+    // Delete absent ennemies
+    auto& positions = getComponent<addon::physic::Position2>();
+    for (size_t idx = EntityField::ENEMIES_BEGIN;
+        idx < EntityField::ENEMIES_END; idx++) {
+        if (idx >= positions.size())
+            break;
+        if (!positions[idx].has_value())
+            continue;
+        if (!present[idx - EntityField::ENEMIES_BEGIN])
+            removeEnnemy(idx, explode);
+    }
 }
 
-int64_t RtypeClient::extractInt64(const std::vector<uint8_t>& data,
-    size_t offset) const {
-    if (offset + sizeof(int64_t) > data.size())
-        throw TypeExtractError("Could not extract int64_t at pos " + offset);
-    int64_t value;
-    std::memcpy(&value, data.data() + offset, sizeof(int64_t));
-    return value;
+void RtypeClient::handleEnnemiesUpdate(const std::vector<uint8_t>& data) {
+    if (data.empty() || getGameState() != IN_GAME)
+        return;
+    FrameVector<EnnemySnapshot> rows(_frame);
+    if (!snapshot::read(data, rows))
+        LOG_WARN("Client", "Truncated ENNEMIES_UPDATE",
+            {{"size", data.size()}});
+    applyEnnemyRows(rows);
 }
 
-void RtypeClient::handleEnnemiesData(const std::vector<uint8_t>& data) {
-    size_t size = data.size();
-    if (size == 0)
+void RtypeClient::handleEnnemiesRemoved(const std::vector<uint8_t>& data) {
+    if (getGameState() != IN_GAME)
         return;
-    size_t follow = 0;
-
-    std::vector<bool> present(
-        (EntityField::ENEMIES_END - EntityField::ENEMIES_BEGIN), false);
-
-    while (follow + sizeof(size_t) + 2 * sizeof(float) <= size) {
-        size_t entity = extractSizeT(data, follow);
-        follow += sizeof(size_t);
-        float posx = extractFloat(data, follow);
-        follow += sizeof(float);
-        float posy = extractFloat(data, follow);
-        follow += sizeof(float);
-        float velx = extractFloat(data, follow);
-        follow += sizeof(float);
-        float vely = extractFloat(data, follow);
-        follow += sizeof(float);
-
-        if (entity < EntityField::ENEMIES_BEGIN ||
-            entity >= EntityField::ENEMIES_END)
+    FrameVector<size_t> rows(_frame);
+    if (!snapshot::read(data, rows))
+        LOG_WARN("Client", "Truncated ENNEMIES_REMOVED",
+            {{"size", data.size()}});
+
+    auto& positions = getComponent<addon::physic::Position2>();
+    for (size_t e : rows) {
+        if (e < EntityField::ENEMIES_BEGIN || e >= EntityField::ENEMIES_END)
             continue;
+        if (e < positions.size() && positions[e].has_value())
+            removeEnnemy(e);
+    }
+}
 
-        present[entity - EntityField::ENEMIES_BEGIN] = true;
+void RtypeClient::applyEnnemyRows(const FrameVector<EnnemySnapshot>& rows) {
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto& velocities = getComponent<addon::physic::Velocity2>();
+
+    bool missed_wave = false;
+    for (const auto& row : rows) {
+        if (row.entity < EntityField::ENEMIES_BEGIN ||
+            row.entity >= EntityField::ENEMIES_END)
+            continue;
+        if (row.entity >= _nextEnnemy)
+            missed_wave = true;
 
-        auto& positions = getComponent<addon::physic::Position2>();
-        auto& velocities = getComponent<addon::physic::Velocity2>();
-        if (entity < positions.size() && positions[entity].has_value()) {
-            positions[entity].value().x = posx;
-            positions[entity].value().y = posy;
+        if (row.entity < positions.size() &&
+            positions[row.entity].has_value()) {
+            positions[row.entity].value().x = row.x;
+            positions[row.entity].value().y = row.y;
         }
-        if (entity < velocities.size() && velocities[entity].has_value()) {
-            velocities[entity].value().x = velx;
-            velocities[entity].value().y = vely;
+        if (row.entity < velocities.size() &&
+            velocities[row.entity].has_value()) {
+            velocities[row.entity].value().x = row.vx;
+            velocities[row.entity].value().y = row.vy;
         }
     }
 
-    // A mettre avant la boucle + enlever celui dedans pour l'opti ?
+    if (missed_wave)
+        sendResyncRequest();
+}
+
+void RtypeClient::removeEnnemy(size_t entity, bool explode) {
     auto& positions = getComponent<addon::physic::Position2>();
 
-    // Delete absent ennemies
-    for (size_t idx = EntityField::ENEMIES_BEGIN;
-        idx < EntityField::ENEMIES_END; idx++) {
-        if (idx >= positions.size())
-            break;
-        if (!positions[idx].has_value())
-            continue;
-        if (!present[idx - EntityField::ENEMIES_BEGIN]) {
-            removeEntity(idx);
-            // std::cout << "deleted ennemy\n";  // Too verbose
-        }
-    }
+    // Mobs leaving through the kill zone on the left do not explode
+    if (explode && positions[entity].value().x > 0.0f)
+        spawnEffect(ParticlePool::EXPLOSION, positions[entity].value().x,
+            positions[entity].value().y);
+    removeEntity(entity);
 }
 
 void RtypeClient::handleProjectilesData(const std::vector<uint8_t>& data) {
-    size_t size = data.size();
-    if (size == 0)
+    if (data.empty() || getGameState() != IN_GAME)
         return;
-    size_t follow = 0;
-
-    std::vector<bool> present(
-        (EntityField::PROJECTILES_END - EntityField::PROJECTILES_BEGIN), false);
-
-
-    while (follow + sizeof(size_t) + 2 * sizeof(float) <= size) {
-        size_t entity = extractSizeT(data, follow);
-        follow += sizeof(size_t);
-        float posx = extractFloat(data, follow);
-        follow += sizeof(float);
-        float posy = extractFloat(data, follow);
-        follow += sizeof(float);
-        float velx = extractFloat(data, follow);
-        follow += sizeof(float);
-        float vely = extractFloat(data, follow);
-        follow += sizeof(float);
-        Weapons weapon = static_cast<Weapons>(extractSizeT(data, follow));
-        follow += sizeof(size_t);
-
-        if (entity < EntityField::PROJECTILES_BEGIN ||
-            entity >= EntityField::PROJECTILES_END) {
-            continue;
-        }
+    FrameVector<ProjectileSnapshot> rows(_frame);
+    if (!snapshot::read(data, rows)) {
+        LOG_WARN("Client", "Truncated PROJECTILES_DATA",
+            {{"size", data.size()}});
+    }
 
-        size_t idx = entity - EntityField::PROJECTILES_BEGIN;
+    FrameVector<bool> present(
+        EntityField::PROJECTILES_END - EntityField::PROJECTILES_BEGIN, false,
+        _frame);
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto& velocities = getComponent<addon::physic::Velocity2>();
 
-        if (idx >= present.size()) {
-            std::cerr << "[ERROR] Index " << idx
-                << " out of bounds for present vector size "
-                << present.size() << "\n";
+    for (const auto& row : rows) {
+        if (row.entity < EntityField::PROJECTILES_BEGIN ||
+            row.entity >= EntityField::PROJECTILES_END ||
+            row.weapon >= Weapons::ENDWEAPON)
             continue;
-        }
 
-        present[idx] = true;
+        present[row.entity - EntityField::PROJECTILES_BEGIN] = true;
 
-        auto& positions = getComponent<addon::physic::Position2>();
-        auto& velocities = getComponent<addon::physic::Velocity2>();
-
-        if ((entity >= positions.size() || !positions[entity].has_value()) ||
-            (entity >= velocities.size() || !velocities[entity].has_value())) {
+        if ((row.entity >= positions.size() ||
+            !positions[row.entity].has_value()) ||
+            (row.entity >= velocities.size() ||
+            !velocities[row.entity].has_value())) {
             _nextProjectile++;
-            createEntity(entity, WEAPONS_NAMES.at(weapon));
+            createEntity(row.entity,
+                WEAPONS_NAMES.at(static_cast<Weapons>(row.weapon)));
         }
-        if (entity < positions.size() && positions[entity].has_value()) {
-            positions[entity].value().x = posx;
-            positions[entity].value().y = posy;
+        if (row.entity < positions.size() &&
+            positions[row.entity].has_value()) {
+            positions[row.entity].value().x = row.x;
+            positions[row.entity].value().y = row.y;
         }
-        if (entity < velocities.size() && velocities[entity].has_value()) {
-            velocities[entity].value().x = velx;
-            velocities[entity].value().y = vely;
+        if (row.entity < velocities.size() &&
+            velocities[row.entity].has_value()) {
+            velocities[row.entity].value().x = row.vx;
+            velocities[row.entity].value().y = row.vy;
         }
     }
 
-    // A mettre avant la boucle + enlever celui dedans pour l'opti ?
-    auto& positions = getComponent<addon::physic::Position2>();
-
     // Delete absent projectiles
     for (size_t idx = EntityField::PROJECTILES_BEGIN;
         idx < EntityField::PROJECTILES_END; idx++) {
@@ -688,49 +863,95 @@ void RtypeClient::handleProjectilesData(const std::vector<uint8_t>& data) {
             break;
         if (!positions[idx].has_value())
             continue;
+        if (!present[idx - EntityField::PROJECTILES_BEGIN])
+            removeEntity(idx);
+    }
+}
 
-        size_t present_idx = idx - EntityField::PROJECTILES_BEGIN;
-        if (present_idx >= present.size()) {
-            std::cerr << "[ERROR] Cleanup: present_idx " << present_idx
-                      << " out of bounds\n";
-            continue;
+void RtypeClient::handleShotConfirmed(const std::vector<uint8_t>& data) {
+    ShotSnapshot row;
+    if (!snapshot::read(data, row)) {
+        LOG_WARN("Client", "Truncated SHOT_CONFIRMED",
+            {{"size", data.size()}});
+        return;
+    }
+    if (getGameState() != IN_GAME || row.weapon >= Weapons::ENDWEAPON ||
+        row.first < EntityField::PROJECTILES_BEGIN ||
+        row.first >= EntityField::PROJECTILES_END)
+        return;
+
+    ShotEntities predicted;
+    if (_my_entity_id.has_value() && row.shooter == _my_entity_id.value()) {
+        auto it = std::find_if(_predictedShots.begin(), _predictedShots.end(),
+            [&row](const PredictedShot& p) { return p.shot == row.shot; });
+        if (it != _predictedShots.end()) {
+            predicted = it->entities;
+            _predictedShots.erase(it);
         }
+    }
 
-        if (!present[present_idx]) {
-            removeEntity(idx);
-            // std::cout << "deleted rocket\n";  // Too verbose
+    size_t next = row.first;
+    auto projectiles = createShot(static_cast<Weapons>(row.weapon),
+        row.shooter, row.shot, {row.x, row.y}, next);
+
+    // The shot left the server half a round trip ago. Our own predicted
+    // projectiles left even earlier, they keep their current position.
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto& velocities = getComponent<addon::physic::Velocity2>();
+    float age = _link.rtt() / 2000.0f;
+    for (size_t i = 0; i < projectiles.size(); ++i) {
+        ECS::Entity e = projectiles[i];
+        if (e >= positions.size() || !positions[e].has_value())
+            continue;
+        auto& pos = positions[e].value();
+        if (i < predicted.size() && predicted[i] < positions.size() &&
+            positions[predicted[i]].has_value()) {
+            pos.x = positions[predicted[i]].value().x;
+            pos.y = positions[predicted[i]].value().y;
+        } else if (e < velocities.size() && velocities[e].has_value()) {
+            pos.x += velocities[e].value().x * age;
+            pos.y += velocities[e].value().y * age;
         }
     }
+
+    for (ECS::Entity e : predicted)
+        if (e < positions.size() && positions[e].has_value())
+            removeEntity(e);
+}
+
+void RtypeClient::handleProjectilesRemoved(const std::vector<uint8_t>& data) {
+    if (getGameState() != IN_GAME)
+        return;
+    FrameVector<size_t> rows(_frame);
+    if (!snapshot::read(data, rows))
+        LOG_WARN("Client", "Truncated PROJECTILES_REMOVED",
+            {{"size", data.size()}});
+
+    auto& positions = getComponent<addon::physic::Position2>();
+    for (size_t e : rows) {
+        if (e < EntityField::PROJECTILES_BEGIN ||
+            e >= EntityField::PROJECTILES_END)
+            continue;
+        if (e < positions.size() && positions[e].has_value())
+            removeEntity(e);
+    }
 }
 
 void RtypeClient::handlePlayersData(const std::vector<uint8_t>& data) {
-    size_t size = data.size();
-    if (size == 0)
+    if (data.empty() || getGameState() != IN_GAME)
         return;
-    size_t follow = 0;
+    FrameVector<PlayerSnapshot> rows(_frame);
+    if (!snapshot::read(data, rows))
+        LOG_WARN("Client", "Truncated PLAYERS_DATA", {{"size", data.size()}});
 
-    std::vector<bool> present(
-        (EntityField::PLAYER_END - EntityField::PLAYER_BEGIN), false);
+    FrameVector<bool> present(
+        EntityField::PLAYER_END - EntityField::PLAYER_BEGIN, false, _frame);
     auto& velocities = getComponent<addon::physic::Velocity2>();
     auto& positions = getComponent<addon::physic::Position2>();
     auto& healths = getComponent<addon::eSpec::Health>();
 
-
-    while (follow + sizeof(size_t) + 2 * sizeof(float) + sizeof(int64_t)
-        <= size) {
-        size_t entity = extractSizeT(data, follow);
-        follow += sizeof(size_t);
-        float posX = extractFloat(data, follow);
-        follow += sizeof(float);
-        float posY = extractFloat(data, follow);
-        follow += sizeof(float);
-        float velX = extractFloat(data, follow);
-        follow += sizeof(float);
-        float velY = extractFloat(data, follow);
-        follow += sizeof(float);
-        int64_t hp = extractInt64(data, follow);
-        follow += sizeof(int64_t);
-
+    for (const auto& row : rows) {
+        size_t entity = row.entity;
         if (entity < EntityField::PLAYER_BEGIN ||
             entity >= EntityField::PLAYER_END ||
             entity >= velocities.size() ||
@@ -741,23 +962,18 @@ void RtypeClient::handlePlayersData(const std::vector<uint8_t>& data) {
 
         present[entity - EntityField::PLAYER_BEGIN] = true;
 
-        // if (_my_entity_id.has_value()
-        //     && entity == _my_entity_id.value()) {
-        //     // recaler myplayer
-        // }
-
         if (!velocities[entity].has_value() ||
             !positions[entity].has_value() ||
             !healths[entity].has_value()) {
             _nextPlayer++;
             std::string playerType = getPlayerTypeByEntityId(entity);
-            createEntity(entity, playerType, {posX, posY});
+            createEntity(entity, playerType, {row.x, row.y});
         } else {
-            velocities[entity].value().x = velX;
-            velocities[entity].value().y = velY;
-            healths[entity].value().amount = hp;
-            positions[entity].value().x = posX;
-            positions[entity].value().y = posY;
+            velocities[entity].value().x = row.vx;
+            velocities[entity].value().y = row.vy;
+            healths[entity].value().amount = row.health;
+            positions[entity].value().x = row.x;
+            positions[entity].value().y = row.y;
         }
     }
 
@@ -766,48 +982,76 @@ void RtypeClient::handlePlayersData(const std::vector<uint8_t>& data) {
         idx < EntityField::PLAYER_END; idx++) {
         if (!velocities[idx].has_value())
             continue;
-        if (!present[idx - EntityField::PLAYER_BEGIN]) {
+        if (!present[idx - EntityField::PLAYER_BEGIN])
             removeEntity(idx);
-            // std::cout << "deleted player\n";  // Too verbose
-        }
     }
 }
 
+void RtypeClient::handleCountdown(const CountdownStart& msg) {
+    LOG_INFO("Client", "Game starting soon", {{"ms", msg.ms}});
+}
+
 void RtypeClient::handleGameStarted(const std::vector<uint8_t>& data) {
-    std::cout << "[Client] Game is starting!\n";
+    LOG_INFO("Client", "Game is starting");
     Game::setGameState(Game::IN_GAME);
 }
 
-void RtypeClient::handleGameEnded(const std::vector<uint8_t>& data) {
-    if (data.size() < 1) {
-        std::cerr << "[Client] Invalid GAME_ENDED packet\n";
-        Game::setGameState(Game::GAME_ENDED);
-        return;
-    }
-
-    bool victory = (data[0] == 1);
+void RtypeClient::handleGameEnded(const GameEnded& msg) {
+    bool victory = (msg.victory == 1);
 
-    std::cout << "\n╔═══════════════════════════════════════╗\n";
-    if (victory) {
-        std::cout << "║           VICTORY!                    ║\n";
-        std::cout << "║  You defeated all enemies! Well done! ║\n";
-    } else {
-        std::cout << "║           DEFEAT!                     ║\n";
-        std::cout << "║     All players have been defeated    ║\n";
-    }
-    std::cout << "╚═══════════════════════════════════════╝\n\n";
+    if (victory)
+        LOG_INFO("Client", "Victory! All enemies defeated");
+    else
+        LOG_INFO("Client", "Defeat! All players have been defeated");
 
     Game::setGameState(Game::GAME_ENDED);
 }
 
-void RtypeClient::handleWaveSpawned(const std::vector<uint8_t>& data) {
-    size_t waveNb = extractSizeT(data, 0);
+void RtypeClient::handleWaveSpawned(const NewWave& msg) {
+    if (getGameState() != IN_GAME)
+        return;
+    size_t waveNb = msg.wave;
 
-    std::cout << "[Client] Spawning wave " << waveNb
-              << " starting at entity " << _nextEnnemy << "\n";
+    size_t first = _nextEnnemy;
     _nextEnnemy = createMobWave(waveNb, _nextEnnemy, EntityField::ENEMIES_END);
-    std::cout << "[Client] Wave " << waveNb
-              << " spawned, next enemy slot: " << _nextEnnemy << "\n";
+    warmWave(waveNb + 1);
+    LOG_INFO("Client", "Wave spawned", {{"wave", waveNb},
+        {"first_entity", first}, {"next_entity", _nextEnnemy}});
+}
+
+void RtypeClient::handleBundle(const std::vector<uint8_t>& data) {
+    bool valid = PacketBundle::unpack(data, _unbundled,
+        [this](uint8_t code, const std::vector<uint8_t>& payload) {
+            if (code != BUNDLE)
+                dispatch(code, payload);
+        });
+
+    if (!valid)
+        LOG_WARN("Client", "Truncated BUNDLE packet",
+            {{"size", data.size()}});
+}
+
+void RtypeClient::handleCompressed(const std::vector<uint8_t>& data) {
+    if (!_codec.decompress(data, _inflated) || _inflated.empty()) {
+        LOG_WARN("Client", "Invalid COMPRESSED packet",
+            {{"size", data.size()}, {"dictionary", _codec.hasDictionary()}});
+        return;
+    }
+
+    // Only state packets are compressed, containers would reuse our buffers
+    uint8_t code = _inflated[0];
+    if (code == COMPRESSED || code == BUNDLE || code == RELIABLE)
+        return;
+    _inflatedPayload.assign(_inflated.begin() + 1, _inflated.end());
+    dispatch(code, _inflatedPayload);
+}
+
+void RtypeClient::handleReliable(const std::vector<uint8_t>& data) {
+    _client.send(_reliable.receive(data,
+        [this](uint8_t code, const std::vector<uint8_t>& payload) {
+            if (code != BUNDLE && code != RELIABLE)
+                dispatch(code, payload);
+        }));
 }
 
 std::string RtypeClient::getPlayerTypeByEntityId(size_t entity_id) const {
@@ -7,32 +7,67 @@
 */
 
 #include <iostream>
+#include <charconv>
+#include <cmath>
 #include <csignal>
 #include <atomic>
 #include <thread>
 #include <chrono>
 #include <string>
+#include <vector>
 #include <ECS/Registry.hpp>
 #include <GameTool.hpp>
 #include <RtypeClient.hpp>
 
+static void printUsage(const char* name) {
+    std::cerr << "usage: " << name
+        << " [ip] [port] [protocol] [--spectate]"
+        << " [--fps <frames per second, 0 = uncapped>]\n";
+}
+
+// Whole argument as a finite number >= 0 (0 uncaps the render rate)
+static bool parseFps(const std::string& text, float& fps) {
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, fps);
+
+    return ec == std::errc() && ptr == end && std::isfinite(fps) && fps >= 0;
+}
+
 int main(int argc, char** argv) {
     std::string server_ip = "127.0.0.1";
     uint16_t port = 8080;
     std::string protocol = "UDP";
+    bool spectator = false;
+    float fps = FPS;
+    std::vector<std::string> args;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--spectate") {
+            spectator = true;
+        } else if (arg == "--fps") {
+            if (i + 1 >= argc || !parseFps(argv[++i], fps)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            args.push_back(arg);
+        }
+    }
 
-    if (argc > 1) {
-        server_ip = argv[1];
+    if (args.size() > 0) {
+        server_ip = args[0];
     }
-    if (argc > 2) {
-        port = static_cast<uint16_t>(std::stoi(argv[2]));
+    if (args.size() > 1) {
+        port = static_cast<uint16_t>(std::stoi(args[1]));
     }
-    if (argc > 3) {
-        protocol = argv[3];
+    if (args.size() > 2) {
+        protocol = args[2];
     }
 
-    RtypeClient client = RtypeClient(protocol, port, server_ip);
+    RtypeClient client = RtypeClient(protocol, port, server_ip, spectator);
 
+    client.setFrameRate(fps);
     client.run();
 
     return 0;
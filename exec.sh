@@ -14,9 +14,9 @@ display_helper() {
 }
 
 clear_project() {
-    rm -rf ./build/ r-type_server r-type_client
+    rm -rf ./build/ r-type_server r-type_client r-type_bench r-type_atlas
     rm -rf ./TrueEngine/*.a ./TrueEngine/plugins/*.so
-    rm -rf ./client/plugins ./server/plugins
+    rm -rf ./client/plugins ./server/plugins ./bench/plugins
 }
 
 if [[ $1 == "--build" || $1 == "-b" ]]
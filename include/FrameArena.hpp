@@ -0,0 +1,72 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** FrameArena.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#define FRAME_ARENA_SIZE (256 * 1024)   // bytes, grows if a tick needs more
+
+// Bump allocator for the transient containers of one tick (decoded rows,
+// presence masks, dead entity lists). Nothing is freed on its own: reset()
+// drops everything at once at the start of the next tick, so containers
+// built on it must not outlive the tick. A tick that does not fit goes to
+// the heap and the block is resized at the next reset, after which the
+// steady state allocates nothing.
+class FrameArena {
+ public:
+    explicit FrameArena(std::size_t capacity = FRAME_ARENA_SIZE);
+
+    void* allocate(std::size_t size, std::size_t align);
+    void reset();
+
+    std::size_t used() const { return _used; }
+    std::size_t capacity() const { return _capacity; }
+
+ private:
+    std::unique_ptr<uint8_t[]> _block;
+    std::size_t _capacity;
+    std::size_t _used = 0;
+    std::size_t _overflowed = 0;    // bytes that went to the heap this tick
+    std::vector<std::unique_ptr<uint8_t[]>> _overflow;
+};
+
+// Standard allocator over a FrameArena, deallocate is a no-op
+template <typename T>
+class ArenaAllocator {
+ public:
+    using value_type = T;
+
+    // Implicit, so containers take the arena itself as their allocator
+    ArenaAllocator(FrameArena& arena) : _arena(&arena) {}  // NOLINT
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+        : _arena(other._arena) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, std::size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return _arena == other._arena;
+    }
+
+ private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    FrameArena* _arena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
@@ -7,9 +7,12 @@
 
 #pragma once
 
+#include <array>
 #include <unordered_map>
 #include <iterator>
+#include <optional>
 #include <string>
+#include <vector>
 #include "ECS/Entity.hpp"
 #include "maths/Vector.hpp"
 
@@ -20,6 +23,10 @@
 #define PLAYERS_FIELD_SIZE 50
 #define ENNEMIES_FIELD_SIZE 100
 #define PROJECTILES_FIELD_SIZE 1000
+#define EFFECTS_FIELD_SIZE 64  // client-only, never replicated
+#define PREDICTED_FIELD_SIZE 64  // client-only, shots not confirmed yet
+#define SHOTGUN_TIMEOUT 1.5f  // seconds, shotgun.timeout in player.toml
+#define SHOTGUN_PELLETS 10  // the widest shot, bounds ShotEntities
 
 enum EntityField : ECS::Entity {
     SYSTEM = 0,
@@ -33,6 +40,23 @@ enum EntityField : ECS::Entity {
     ENEMIES_END = ENEMIES_BEGIN + ENNEMIES_FIELD_SIZE,
     PROJECTILES_BEGIN = ENEMIES_END + 1,
     PROJECTILES_END = PROJECTILES_BEGIN + PROJECTILES_FIELD_SIZE,
+    EFFECTS_BEGIN = PROJECTILES_END + 1,
+    EFFECTS_END = EFFECTS_BEGIN + EFFECTS_FIELD_SIZE,
+    PREDICTED_BEGIN = EFFECTS_END + 1,
+    PREDICTED_END = PREDICTED_BEGIN + PREDICTED_FIELD_SIZE,
+    WARMUP = PREDICTED_END + 1,  // client-only, scratch for texture warm-up
+};
+
+// Projectiles of one shot, inline so that firing allocates nothing
+struct ShotEntities {
+    std::array<ECS::Entity, SHOTGUN_PELLETS> entities{};
+    std::size_t count = 0;
+
+    std::size_t size() const { return count; }
+    ECS::Entity operator[](std::size_t i) const { return entities[i]; }
+    ECS::Entity front() const { return entities[0]; }
+    const ECS::Entity* begin() const { return entities.data(); }
+    const ECS::Entity* end() const { return entities.data() + count; }
 };
 
 class Game : public te::GameTool {
@@ -54,7 +78,8 @@ class Game : public te::GameTool {
     enum GAME_STATE : uint8_t {
       GAME_WAITING = 1,
       IN_GAME = 2,
-      GAME_ENDED = 3
+      GAME_ENDED = 3,
+      GAME_COUNTDOWN = 4
     };
 
  public:
@@ -67,6 +92,13 @@ class Game : public te::GameTool {
  private:
     GAME_STATE _game_state = GAME_WAITING;
 
+    struct BaselineEntity {
+        ECS::Entity entity;
+        std::string name;
+        std::optional<mat::Vector2f> pos;
+    };
+    std::vector<BaselineEntity> _baseline;
+
  protected:
     std::size_t createMobWave(
       std::size_t type, std::size_t begin = EntityField::ENEMIES_BEGIN,
@@ -76,4 +108,30 @@ class Game : public te::GameTool {
         std::size_t end = EntityField::MAP_END);
 
     void createProjectile(ECS::Entity e);
+
+    // Projectiles of one shot fired from `origin`, placed at `next` and
+    // wrapping inside [begin, end). The spread only depends on `shooter`
+    // and `shot`, so the client predicts the exact same projectiles.
+    ShotEntities createShot(Weapons weapon, std::size_t shooter,
+        uint16_t shot, mat::Vector2f origin, std::size_t& next,
+        std::size_t begin = EntityField::PROJECTILES_BEGIN,
+        std::size_t end = EntityField::PROJECTILES_END);
+
+    // Removes only the occupied slots of [begin, end), returns the count
+    std::size_t clearField(std::size_t begin, std::size_t end);
+    // Clears the map, players, ennemies and projectiles fields
+    std::size_t clearMatchFields();
+
+    // Lobby baseline: entities recreated as fresh by restoreBaseline()
+    void setBaseline(ECS::Entity e, const std::string& name,
+        std::optional<mat::Vector2f> pos = std::nullopt);
+    void unsetBaseline(ECS::Entity e);
+    void restoreBaseline();
+
+    // Snapshot rows of every live entity of a field, see Snapshot.hpp
+    void encodePlayersData(std::vector<uint8_t>& packet);
+    void encodeEnnemiesData(std::vector<uint8_t>& packet);
+    void encodeProjectilesData(std::vector<uint8_t>& packet);
+    // Full match state for a client that missed something
+    void encodeKeyframe(std::vector<uint8_t>& packet, std::size_t waves);
 };
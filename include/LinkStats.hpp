@@ -0,0 +1,69 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** LinkStats.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define PING_TIMEOUT 2000               // milliseconds
+#define LINK_PING_SIZE 12               // PING/PONG payload, [4B seq][8B time]
+
+// Round trip time, jitter and loss of one connection, measured with
+// sequence-numbered PING packets: [PING][4B seq][8B send time in us].
+// The peer echoes the payload in its PONG, so only the sender's clock
+// is ever used.
+class LinkStats {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit LinkStats(float timeout_ms = PING_TIMEOUT);
+
+    // Both write into `packet`, a buffer reused by the caller
+    void makePing(std::vector<uint8_t>& packet);
+    static void makePong(const std::vector<uint8_t>& ping,
+        std::vector<uint8_t>& packet);
+
+    // data is a PONG payload, returns false if it matches no pending ping
+    bool onPong(const std::vector<uint8_t>& data);
+    // Counts pings older than the timeout as lost
+    void checkTimeouts();
+
+    float rtt() const { return _srtt; }             // milliseconds
+    float jitter() const { return _jitter; }        // milliseconds
+    float loss() const { return _loss; }            // ratio [0, 1]
+    float lastRtt() const { return _last_rtt; }     // milliseconds
+    uint64_t samples() const { return _samples; }
+    uint64_t sent() const { return _sent; }
+    uint64_t lost() const { return _lost; }
+
+    void reset();
+
+ private:
+    struct PendingPing {
+        uint32_t seq;
+        Clock::time_point sent;
+    };
+
+    float _timeout_ms;
+    uint32_t _next_seq = 0;
+    // Oldest first, a vector rather than a deque so it keeps its capacity
+    std::vector<PendingPing> _pending;
+
+    float _srtt = 0.0f;
+    float _jitter = 0.0f;
+    float _loss = 0.0f;
+    float _last_rtt = 0.0f;
+    uint64_t _samples = 0;
+    uint64_t _sent = 0;
+    uint64_t _lost = 0;
+
+    void onOutcome(bool lost);
+};
@@ -0,0 +1,169 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** Logger.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_OFF 4
+
+// Calls below this level are compiled out: arguments are still type
+// checked but never evaluated, no code is emitted
+#ifndef RT_LOG_LEVEL
+    #define RT_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_QUEUE_SIZE 1024             // records, power of two
+#define LOG_RECORD_SIZE 256             // bytes per formatted line
+#define LOG_TAG_SIZE 16
+
+enum class LogLevel : uint8_t {
+    Debug = LOG_LEVEL_DEBUG,
+    Info = LOG_LEVEL_INFO,
+    Warn = LOG_LEVEL_WARN,
+    Error = LOG_LEVEL_ERROR,
+};
+
+// One `key=value` pair appended to a log line
+class LogField {
+ public:
+    template <std::integral T>
+    LogField(std::string_view key, T value) : _key(key) {
+        if constexpr (std::is_signed_v<T>) {
+            _kind = SIGNED;
+            _signed = static_cast<int64_t>(value);
+        } else {
+            _kind = UNSIGNED;
+            _unsigned = static_cast<uint64_t>(value);
+        }
+    }
+    LogField(std::string_view key, double value)
+        : _key(key), _kind(REAL), _real(value) {}
+    LogField(std::string_view key, std::string_view value)
+        : _key(key), _kind(TEXT), _text(value) {}
+    LogField(std::string_view key, const char* value)
+        : _key(key), _kind(TEXT), _text(value) {}
+    LogField(std::string_view key, const std::string& value)
+        : _key(key), _kind(TEXT), _text(value) {}
+
+    // Writes ` key=value` at buf, returns the number of bytes written
+    std::size_t format(char* buf, std::size_t size) const;
+
+ private:
+    enum Kind : uint8_t { SIGNED, UNSIGNED, REAL, TEXT };
+
+    std::string_view _key;
+    Kind _kind;
+    union {
+        int64_t _signed;
+        uint64_t _unsigned;
+        double _real;
+    };
+    std::string_view _text;
+};
+
+// Formats on the calling thread into a lock-free ring buffer, a background
+// thread does the actual I/O. When the ring is full the record is dropped
+// and counted: logging never blocks the caller.
+class Logger {
+ public:
+    static Logger& get();
+
+    void write(LogLevel level, std::string_view tag, std::string_view message,
+        std::initializer_list<LogField> fields = {});
+
+    void setLevel(LogLevel level) { _level.store(level); }
+    bool enabled(LogLevel level) const { return level >= _level.load(); }
+    uint64_t dropped() const { return _dropped.load(); }
+
+    // Blocks until every record queued so far has been written
+    void flush();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+ private:
+    struct Record {
+        LogLevel level;
+        std::chrono::system_clock::time_point time;
+        char tag[LOG_TAG_SIZE];
+        char text[LOG_RECORD_SIZE];
+        std::size_t length;
+    };
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        Record record;
+    };
+
+    Logger();
+    ~Logger();
+
+    bool pop(Record& record);
+    void writeRecord(const Record& record) const;
+    void writerLoop();
+
+    std::array<Cell, LOG_QUEUE_SIZE> _cells;
+    alignas(64) std::atomic<std::size_t> _enqueue = 0;
+    alignas(64) std::atomic<std::size_t> _dequeue = 0;
+    std::atomic<uint64_t> _dropped = 0;
+    std::atomic<uint64_t> _written = 0;
+    std::atomic<LogLevel> _level = static_cast<LogLevel>(
+        RT_LOG_LEVEL < LOG_LEVEL_OFF ? RT_LOG_LEVEL : LOG_LEVEL_ERROR);
+    std::atomic<bool> _running = true;
+    std::thread _writer;
+};
+
+#define LOG_WRITE(level, ...) \
+    do { \
+        if (Logger::get().enabled(level)) \
+            Logger::get().write(level, __VA_ARGS__); \
+    } while (0)
+
+#define LOG_DISCARD(level, ...) \
+    do { \
+        if constexpr (false) \
+            Logger::get().write(level, __VA_ARGS__); \
+    } while (0)
+
+#if RT_LOG_LEVEL <= LOG_LEVEL_DEBUG
+    #define LOG_DEBUG(...) LOG_WRITE(LogLevel::Debug, __VA_ARGS__)
+#else
+    #define LOG_DEBUG(...) LOG_DISCARD(LogLevel::Debug, __VA_ARGS__)
+#endif
+
+#if RT_LOG_LEVEL <= LOG_LEVEL_INFO
+    #define LOG_INFO(...) LOG_WRITE(LogLevel::Info, __VA_ARGS__)
+#else
+    #define LOG_INFO(...) LOG_DISCARD(LogLevel::Info, __VA_ARGS__)
+#endif
+
+#if RT_LOG_LEVEL <= LOG_LEVEL_WARN
+    #define LOG_WARN(...) LOG_WRITE(LogLevel::Warn, __VA_ARGS__)
+#else
+    #define LOG_WARN(...) LOG_DISCARD(LogLevel::Warn, __VA_ARGS__)
+#endif
+
+#if RT_LOG_LEVEL <= LOG_LEVEL_ERROR
+    #define LOG_ERROR(...) LOG_WRITE(LogLevel::Error, __VA_ARGS__)
+#else
+    #define LOG_ERROR(...) LOG_DISCARD(LogLevel::Error, __VA_ARGS__)
+#endif
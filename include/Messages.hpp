@@ -0,0 +1,88 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** Messages.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <Protocol.hpp>
+#include <Wire.hpp>
+
+// Fixed size control messages, encoded and decoded from these schemas on
+// both sides, see Wire.hpp. Row based packets live in Snapshot.hpp.
+
+struct ConnectionRequest {
+    static constexpr ProtocolCode CODE = CONNECTION_REQUEST;
+    uint64_t cookie;  // 0 until a CONNECTION_CHALLENGE was received
+    uint64_t token;   // 0 for a new player
+
+    static constexpr auto FIELDS = std::make_tuple(
+        &ConnectionRequest::cookie, &ConnectionRequest::token);
+};
+
+struct ConnectionAccepted {
+    static constexpr ProtocolCode CODE = CONNECTION_ACCEPTED;
+    uint64_t entity;
+    uint64_t token;
+
+    static constexpr auto FIELDS = std::make_tuple(
+        &ConnectionAccepted::entity, &ConnectionAccepted::token);
+};
+
+struct Spectate {
+    static constexpr ProtocolCode CODE = SPECTATE;
+    uint64_t cookie;
+
+    static constexpr auto FIELDS = std::make_tuple(&Spectate::cookie);
+};
+
+struct ConnectionChallenge {
+    static constexpr ProtocolCode CODE = CONNECTION_CHALLENGE;
+    uint64_t cookie;
+
+    static constexpr auto FIELDS = std::make_tuple(
+        &ConnectionChallenge::cookie);
+};
+
+struct CountdownStart {
+    static constexpr ProtocolCode CODE = GAME_COUNTDOWN_START;
+    uint32_t ms;
+
+    static constexpr auto FIELDS = std::make_tuple(&CountdownStart::ms);
+};
+
+struct GameEnded {
+    static constexpr ProtocolCode CODE = GAME_ENDED;
+    uint8_t victory;
+
+    static constexpr auto FIELDS = std::make_tuple(&GameEnded::victory);
+};
+
+struct NewWave {
+    static constexpr ProtocolCode CODE = NEW_WAVE;
+    uint32_t wave;
+
+    static constexpr auto FIELDS = std::make_tuple(&NewWave::wave);
+};
+
+struct PlayerShot {
+    static constexpr ProtocolCode CODE = PLAYER_SHOT;
+    uint8_t weapon;
+    uint16_t shot;  // picked by the client, echoed in SHOT_CONFIRMED
+
+    static constexpr auto FIELDS = std::make_tuple(&PlayerShot::weapon,
+        &PlayerShot::shot);
+};
+
+struct Ack {
+    static constexpr ProtocolCode CODE = ACK;
+    uint16_t ack;
+    uint32_t bits;
+
+    static constexpr auto FIELDS = std::make_tuple(&Ack::ack, &Ack::bits);
+};
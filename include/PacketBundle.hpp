@@ -0,0 +1,49 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** PacketBundle.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#define BUNDLE_MAX_SIZE 1200    // bytes, keeps a bundle under the path MTU
+
+// Packs several protocol packets ([code][payload]) into one BUNDLE datagram:
+// [BUNDLE][N x (1B code + 2B payload size + payload)]
+class PacketBundle {
+ public:
+    using Handler =
+        std::function<void(uint8_t code, const std::vector<uint8_t>& data)>;
+
+    explicit PacketBundle(std::size_t max_size = BUNDLE_MAX_SIZE);
+
+    // Returns false when the packet does not fit, the bundle is left intact
+    bool add(const std::vector<uint8_t>& packet);
+    bool fits(const std::vector<uint8_t>& packet) const;
+
+    void clear();
+    bool empty() const { return _count == 0; }
+    std::size_t count() const { return _count; }
+    std::size_t size() const { return _data.size(); }
+    const std::vector<uint8_t>& data() const { return _data; }
+
+    void setMaxSize(std::size_t max_size) { _max_size = max_size; }
+
+    // data is a BUNDLE payload (code byte already stripped). Each inner
+    // payload is copied into `payload`, a buffer reused by the caller, so
+    // the handler must not unpack into it again.
+    static bool unpack(const std::vector<uint8_t>& data,
+        std::vector<uint8_t>& payload, const Handler& handler);
+
+ private:
+    std::vector<uint8_t> _data;
+    std::size_t _max_size;
+    std::size_t _count = 0;
+};
@@ -0,0 +1,50 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** PacketCodec.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define COMPRESSION_THRESHOLD 256       // bytes, smaller packets sent as is
+#define COMPRESSION_DICT "config/compression.dict"
+#define COMPRESSION_MAX_DICT 16384      // bytes kept from the dictionary file
+
+// Byte-oriented LZ77 for full-state packets (keyframes, correction dumps).
+// A whole protocol packet ([code][payload]) is wrapped as
+// [COMPRESSED][2B raw size][1B flags][stream], flags bit 0 telling that
+// the dictionary was used. Stream ops:
+//   0x00-0x7f  literal run of (op + 1) bytes, bytes follow
+//   0x80-0xff  match of (op - 0x80 + 4) bytes, 2B distance follows
+// The optional dictionary is prepended to the history on both sides, it
+// should hold typical traffic (e.g. captured keyframes) and must be the
+// same file on the server and the clients.
+class PacketCodec {
+ public:
+    PacketCodec() = default;
+
+    // Returns false when the file is missing, the codec then runs without
+    bool loadDictionary(const std::string& path = COMPRESSION_DICT);
+    bool hasDictionary() const { return !_dict.empty(); }
+
+    // Writes the COMPRESSED packet into `out`, false when the packet does
+    // not shrink, send it as is then
+    bool compress(const std::vector<uint8_t>& packet,
+        std::vector<uint8_t>& out);
+    // data is a COMPRESSED payload (code byte stripped), `packet` receives
+    // the original [code][payload]. Fails as soon as the stream would
+    // expand past its raw size, untrusted input cannot inflate memory
+    bool decompress(const std::vector<uint8_t>& data,
+        std::vector<uint8_t>& packet);
+
+ private:
+    std::vector<uint8_t> _dict;
+    std::vector<uint8_t> _history;  // dictionary + packet, keeps its capacity
+};
@@ -19,19 +19,32 @@ enum PLAYER_STATE : uint8_t {
 
 // Protocol codes - using enum instead of enum class to avoid casting
 enum ProtocolCode : uint8_t {
-    CONNECTION_REQUEST = 1,
+    CONNECTION_REQUEST = 1,  // Client send: [u64 cookie][u64 token], 0 = none
     DISCONNECTION = 2,
     ERROR_TOO_MANY_CLIENTS = 3,
-    CONNECTION_ACCEPTED = 4,  // Server → Client: [uint32_t entity_id]
+    CONNECTION_ACCEPTED = 4,  // Server → Client: [entity_id][uint64_t token]
     PING = 6,
     PONG = 7,
+    SPECTATE = 8,  // Client send: [u64 cookie], read-only, answered by KEYFRAME
+    CONNECTION_CHALLENGE = 9,  // Server → Client: [u64 cookie] to send back
     WANT_START = 35,  // client send
     GAME_START = 36,  // server send
+    GAME_COUNTDOWN_START = 39,  // Server send: [uint32_t ms before start]
     GAME_ENDED = 49,  // Server send
     CLIENT_EVENT = 50,
     PLAYERS_DATA = 51,    // Broadcast players positions
     PROJECTILES_DATA = 52,   // Broadcast projectiles positions
     NEW_WAVE = 53,          // Broadcast ennemies waves spawns
     ENNEMIES_DATA = 54,   // Broadcast entities positions (float)
-    PLAYER_SHOT = 55
+    PLAYER_SHOT = 55,  // Client send: [uint8_t weapon][uint16_t shot id]
+    SHOT_CONFIRMED = 58,  // Server send: one ShotSnapshot, see Snapshot.hpp
+    RESYNC_REQUEST = 59,  // Client send: asks for a KEYFRAME
+    BUNDLE = 62,  // Server → Client: several packets in one datagram
+    RELIABLE = 63,  // [uint16_t seq][packet], see ReliableChannel.hpp
+    ACK = 64,       // [uint16_t ack][uint32_t bits]
+    KEYFRAME = 65,  // Server send: full match state, see Snapshot.hpp
+    PROJECTILES_REMOVED = 66,  // Server send: [entity ids] hit or gone
+    ENNEMIES_REMOVED = 67,     // Server send: [entity ids] killed or gone
+    ENNEMIES_UPDATE = 68,      // Server send: rows of 54 for hit ennemies
+    COMPRESSED = 69   // Server send: one packet, see PacketCodec.hpp
 };
@@ -0,0 +1,87 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** ReliableChannel.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <Messages.hpp>
+
+#define RELIABLE_RESEND_TIME 200        // milliseconds
+#define RELIABLE_WINDOW 32              // messages in flight / out of order
+#define RELIABLE_STALL_TIME 5000        // milliseconds with a full window
+
+// Sequenced, acknowledged and ordered delivery for control messages on
+// top of the unreliable transport. Snapshots never go through it.
+// At most RELIABLE_WINDOW messages are in flight, the receiver drops
+// anything further ahead, so later ones wait unsequenced for acks.
+//
+// [RELIABLE][2B seq][wrapped packet: code + payload]
+// [ACK][2B ack][4B bits]: every seq up to `ack` was delivered, bit i set
+// means ack + 2 + i was received and is waiting for a gap to be filled.
+class ReliableChannel {
+ public:
+    using Clock = std::chrono::steady_clock;
+    using Handler = std::function<void(uint8_t code,
+        const std::vector<uint8_t>& payload)>;
+    using Sender = std::function<void(const std::vector<uint8_t>& packet)>;
+
+    // Sender side: wraps a packet and keeps it until it is acked. The
+    // wrapped packet stays valid until the next wrap() or onAck(), nullptr
+    // when the window is full and the packet was queued for release().
+    const std::vector<uint8_t>* wrap(const std::vector<uint8_t>& packet);
+    void onAck(const Ack& msg);
+    // Wraps and sends the queued packets the window has room for
+    void release(const Sender& send);
+    // Sends the packets unacked for longer than timeout_ms, their timer
+    // restarts
+    void resends(float timeout_ms, const Sender& send);
+    std::size_t pending() const { return _pending.size() + _queued.size(); }
+    // Milliseconds the window has been full, 0 when it has room
+    float stalled() const;
+
+    // Receiver side: data is a RELIABLE payload, in order packets are
+    // passed to the handler. Returns the ACK packet to send back, valid
+    // until the next receive(). The handler must not receive() again.
+    const std::vector<uint8_t>& receive(const std::vector<uint8_t>& data,
+        const Handler& handler);
+
+    void reset();
+
+ private:
+    struct PendingMessage {
+        uint16_t seq;
+        std::vector<uint8_t> packet;
+        Clock::time_point sent;
+    };
+
+    uint16_t _next_seq = 0;
+    // Acked packets go back to _spare, wrap() reuses their capacity
+    std::vector<PendingMessage> _pending;
+    std::deque<std::vector<uint8_t>> _queued;   // unsequenced, window full
+    std::vector<std::vector<uint8_t>> _spare;
+    std::optional<Clock::time_point> _full_since;
+
+    uint16_t _next_expected = 0;
+    // Only filled on loss, in order packets are delivered from the datagram
+    std::unordered_map<uint16_t, std::vector<uint8_t>> _buffered;
+    std::vector<uint8_t> _payload;
+    std::vector<uint8_t> _ack;
+
+    const std::vector<uint8_t>& sequence(const std::vector<uint8_t>& packet);
+    std::vector<uint8_t> takeSpare();
+    void makeAck();
+    void deliver(const uint8_t* packet, std::size_t size,
+        const Handler& handler);
+};
@@ -0,0 +1,119 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** Snapshot.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include <FrameArena.hpp>
+
+// Rows of the PLAYERS_DATA / ENNEMIES_DATA / PROJECTILES_DATA packets,
+// fields big endian in FIELDS order and packed without separators, see
+// Wire.hpp
+struct PlayerSnapshot {
+    std::size_t entity;
+    float x;
+    float y;
+    float vx;
+    float vy;
+    int64_t health;
+
+    static constexpr auto FIELDS = std::make_tuple(&PlayerSnapshot::entity,
+        &PlayerSnapshot::x, &PlayerSnapshot::y, &PlayerSnapshot::vx,
+        &PlayerSnapshot::vy, &PlayerSnapshot::health);
+};
+
+struct EnnemySnapshot {
+    std::size_t entity;
+    float x;
+    float y;
+    float vx;
+    float vy;
+
+    static constexpr auto FIELDS = std::make_tuple(&EnnemySnapshot::entity,
+        &EnnemySnapshot::x, &EnnemySnapshot::y, &EnnemySnapshot::vx,
+        &EnnemySnapshot::vy);
+};
+
+struct ProjectileSnapshot {
+    std::size_t entity;
+    float x;
+    float y;
+    float vx;
+    float vy;
+    std::size_t weapon;
+
+    static constexpr auto FIELDS = std::make_tuple(
+        &ProjectileSnapshot::entity, &ProjectileSnapshot::x,
+        &ProjectileSnapshot::y, &ProjectileSnapshot::vx,
+        &ProjectileSnapshot::vy, &ProjectileSnapshot::weapon);
+};
+
+// SHOT_CONFIRMED payload: a whole shot in one row, clients rebuild its
+// projectiles with Game::createShot from the shooter and shot id seed,
+// placed from `first` on and then moving on their own
+struct ShotSnapshot {
+    std::size_t shooter;
+    uint16_t shot;
+    uint8_t weapon;
+    std::size_t first;
+    float x;
+    float y;
+
+    static constexpr auto FIELDS = std::make_tuple(&ShotSnapshot::shooter,
+        &ShotSnapshot::shot, &ShotSnapshot::weapon, &ShotSnapshot::first,
+        &ShotSnapshot::x, &ShotSnapshot::y);
+};
+
+// KEYFRAME payload: [1B game state][4B waves spawned] then the players,
+// ennemies and projectiles rows, each section prefixed by its 4B size
+struct Keyframe {
+    uint8_t state;
+    uint32_t waves;
+    std::vector<uint8_t> players;
+    std::vector<uint8_t> ennemies;
+    std::vector<uint8_t> projectiles;
+};
+
+namespace snapshot {
+
+void write(std::vector<uint8_t>& packet, const PlayerSnapshot& row);
+void write(std::vector<uint8_t>& packet, const EnnemySnapshot& row);
+void write(std::vector<uint8_t>& packet, const ProjectileSnapshot& row);
+void write(std::vector<uint8_t>& packet, const ShotSnapshot& row);
+
+// data is the packet payload (code byte stripped), rows are appended to
+// `rows`. Returns false when trailing bytes do not form a full row.
+// Instantiated for std::allocator and ArenaAllocator rows.
+template <typename Alloc>
+bool read(const std::vector<uint8_t>& data,
+    std::vector<PlayerSnapshot, Alloc>& rows);
+template <typename Alloc>
+bool read(const std::vector<uint8_t>& data,
+    std::vector<EnnemySnapshot, Alloc>& rows);
+template <typename Alloc>
+bool read(const std::vector<uint8_t>& data,
+    std::vector<ProjectileSnapshot, Alloc>& rows);
+
+// Reserves a 4B size prefix, the section ends at the next endSection()
+std::size_t beginSection(std::vector<uint8_t>& packet);
+void endSection(std::vector<uint8_t>& packet, std::size_t section);
+
+bool read(const std::vector<uint8_t>& data, Keyframe& frame);
+bool read(const std::vector<uint8_t>& data, ShotSnapshot& row);
+
+// PROJECTILES_REMOVED payload, packed entity ids
+void write(std::vector<uint8_t>& packet, std::size_t entity);
+template <typename Alloc>
+bool read(const std::vector<uint8_t>& data,
+    std::vector<std::size_t, Alloc>& rows);
+
+}  // namespace snapshot
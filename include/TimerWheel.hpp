@@ -0,0 +1,70 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** TimerWheel.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#define TIMER_WHEEL_BITS 6              // 64 slots per level
+#define TIMER_WHEEL_LEVELS 4            // 2^24 ticks, ~46 h at 10 ms
+
+// Hierarchical timer wheel: scheduling and cancelling are O(1), and
+// advance() only touches the slots of the ticks that went by, however many
+// timers are pending. Timers further than one level away sit in a coarser
+// level and cascade down when their slot comes up.
+// Callbacks run from advance(), they may schedule or cancel timers.
+class TimerWheel {
+ public:
+    using Clock = std::chrono::steady_clock;
+    using Id = uint64_t;              // 0 is never returned
+    using Callback = std::function<void()>;
+
+    // Delays are rounded up to whole ticks of `tick` seconds
+    explicit TimerWheel(float tick);
+
+    Id after(float seconds, Callback callback);
+    Id every(float seconds, Callback callback);
+    // No-op for ids that already fired or were cancelled
+    void cancel(Id id);
+
+    // Runs every timer due at `now`, call it once per tick
+    void advance(Clock::time_point now = Clock::now());
+
+    std::size_t size() const { return _pending; }
+
+ private:
+    struct Timer {
+        uint64_t when = 0;
+        uint64_t period = 0;          // in ticks, 0 for one-shot
+        uint32_t generation = 1;
+        bool active = false;
+        Callback callback;
+    };
+    using Slot = std::vector<uint32_t>;
+
+    Clock::duration _tick;
+    Clock::time_point _origin;
+    uint64_t _now = 0;
+    std::size_t _pending = 0;
+    std::deque<Timer> _timers;      // stable while callbacks run
+    std::vector<uint32_t> _free;
+    std::array<std::array<Slot, 1 << TIMER_WHEEL_BITS>,
+        TIMER_WHEEL_LEVELS> _wheel;
+
+    Id schedule(float seconds, bool repeat, Callback callback);
+    void insert(uint32_t index);
+    void release(uint32_t index);
+    void cascade(std::size_t level);
+    void step();
+};
@@ -0,0 +1,145 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** Wire.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Payload fields are big endian, as stated in PROTOCOL.md and
+// config/protocol.json, whatever the host byte order
+namespace wire {
+
+template <typename T>
+using Bits = std::conditional_t<sizeof(T) == 1, uint8_t,
+    std::conditional_t<sizeof(T) == 2, uint16_t,
+    std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+template <typename T>
+inline uint8_t* put(uint8_t* out, T value) {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+    auto bits = std::bit_cast<Bits<T>>(value);
+
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+        out[i] = static_cast<uint8_t>(bits >> (8 * (sizeof(T) - 1 - i)));
+    return out + sizeof(T);
+}
+
+template <typename T>
+inline const uint8_t* get(const uint8_t* in, T& value) {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+    Bits<T> bits = 0;
+
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+        bits = static_cast<Bits<T>>((bits << 8) | in[i]);
+    value = std::bit_cast<T>(bits);
+    return in + sizeof(T);
+}
+
+}  // namespace wire
+
+// A message schema lists its fields once, in wire order:
+//
+//   struct NewWave {
+//       static constexpr ProtocolCode CODE = NEW_WAVE;
+//       uint32_t wave;
+//       static constexpr auto FIELDS = std::make_tuple(&NewWave::wave);
+//   };
+//
+// Its payload size is known at compile time, encode() sizes the packet once
+// and decode() checks the payload size once before reading the fields.
+// Snapshot rows use the same FIELDS lists without a CODE.
+namespace message {
+
+template <typename M>
+constexpr std::size_t size() {
+    return std::apply([](auto... field) {
+        return (std::size_t{0} + ... + sizeof(std::declval<M&>().*field));
+    }, M::FIELDS);
+}
+
+// Fields only, the caller has checked that size<M>() bytes are there
+template <typename M>
+uint8_t* put(uint8_t* out, const M& msg) {
+    std::apply([&](auto... field) {
+        ((out = wire::put(out, msg.*field)), ...);
+    }, M::FIELDS);
+    return out;
+}
+
+template <typename M>
+const uint8_t* get(const uint8_t* in, M& msg) {
+    std::apply([&](auto... field) {
+        ((in = wire::get(in, msg.*field)), ...);
+    }, M::FIELDS);
+    return in;
+}
+
+// [CODE][fields], into `packet` so that a reused buffer keeps its capacity
+template <typename M>
+void encode(const M& msg, std::vector<uint8_t>& packet) {
+    packet.resize(1 + size<M>());
+    packet[0] = M::CODE;
+    put(packet.data() + 1, msg);
+}
+
+// payload is the packet without its code byte, sizes must match exactly
+template <typename M>
+bool decode(const std::vector<uint8_t>& payload, M& msg) {
+    if (payload.size() != size<M>())
+        return false;
+    get(payload.data(), msg);
+    return true;
+}
+
+// Code -> handler table built at compile time. Each entry is a plain
+// function that either hands the raw payload over or decodes it against a
+// schema first, so dispatching is one indexed call.
+template <typename Owner, typename... Args>
+struct Router {
+    using Thunk = void (*)(Owner&, const std::vector<uint8_t>&, Args...);
+    using Table = std::array<Thunk, 256>;
+    struct Route {
+        uint8_t code;
+        Thunk thunk;
+    };
+
+    template <void (Owner::*Handler)(const std::vector<uint8_t>&, Args...)>
+    static constexpr Route raw(uint8_t code) {
+        return {code, [](Owner& owner, const std::vector<uint8_t>& payload,
+            Args... args) { (owner.*Handler)(payload, args...); }};
+    }
+
+    // Payloads that do not match the schema size are dropped
+    template <typename M, void (Owner::*Handler)(const M&, Args...)>
+    static constexpr Route typed() {
+        return {M::CODE, [](Owner& owner, const std::vector<uint8_t>& payload,
+            Args... args) {
+            M msg;
+            if (decode(payload, msg))
+                (owner.*Handler)(msg, args...);
+        }};
+    }
+
+    static constexpr Table table(std::initializer_list<Route> routes) {
+        Table table{};
+
+        for (const Route& route : routes)
+            table[route.code] = route.thunk;
+        return table;
+    }
+};
+
+}  // namespace message
@@ -0,0 +1,57 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** ClientSession.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <network/GameServer.hpp>
+#include <PacketBundle.hpp>
+#include <RateController.hpp>
+#include <IngressLimiter.hpp>
+#include <LinkStats.hpp>
+#include <ReliableChannel.hpp>
+#include <ServerConfig.hpp>
+
+// Everything the server keeps about one connected player. A session
+// that drops without DISCONNECTION is parked: its entity stays in game
+// and a CONNECTION_REQUEST carrying its token reclaims it within the
+// grace window.
+struct ClientSession {
+    net::Address address;
+    size_t entity;
+    uint64_t token;
+    bool parked = false;
+    std::chrono::steady_clock::time_point parked_at;
+    PacketBundle outbox;
+    RateController rate;
+    LinkStats link;
+    ReliableChannel reliable;
+    IngressLimiter ingress;
+
+    ClientSession(const net::Address& addr, size_t entity_id,
+        uint64_t session_token, const ServerConfig& config)
+        : address(addr)
+        , entity(entity_id)
+        , token(session_token)
+        , outbox(config.bundle_max_size)
+        , rate(config.adaptive)
+        , link(config.ping_timeout)
+        , ingress(config.ingress) {}
+};
+
+// Read-only viewer, no entity, no reliable channel. It still pings and
+// may leave, within its own budget.
+struct Spectator {
+    net::Address address;
+    IngressLimiter ingress;
+
+    Spectator(const net::Address& addr, const ServerConfig& config)
+        : address(addr), ingress(config.ingress) {}
+};
@@ -0,0 +1,36 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** CookieJar.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#define COOKIE_LIFETIME 10              // seconds, cookies last 1 to 2 of these
+
+// Stateless handshake cookies: a cookie is a keyed hash (SipHash-2-4) of
+// the sender address and the current time window, so the server can
+// check that a client received its answer without storing anything.
+class CookieJar {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    CookieJar();  // random key, cookies do not survive a restart
+
+    uint64_t issue(const std::string& addr, Clock::time_point now) const;
+    // Accepts cookies of the current and the previous time window
+    bool check(uint64_t cookie, const std::string& addr,
+        Clock::time_point now) const;
+
+ private:
+    uint64_t _key[2];
+
+    uint64_t make(const std::string& addr, uint64_t window) const;
+    static uint64_t window(Clock::time_point now);
+};
@@ -0,0 +1,131 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** FlightRecorder.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define FLIGHT_RECORDER_PATH "flight.rec"
+#define FLIGHT_DUMP_PREFIX "flight-"      // + unix seconds-reason.rec
+#define FLIGHT_MAGIC 0x54484749464c5452ULL    // "RTFLIGHT"
+#define FLIGHT_VERSION 1
+
+// Always-on ring of the last ticks, kept in a memory-mapped file so it
+// survives a crash of the process. A clean shutdown removes that file,
+// a leftover one is moved to flight-<time>-crash.rec by the next start
+// before the new ring truncates it. Recording a tick is a few clock reads
+// and stores into the mapping, nothing is allocated or written to disk.
+// dump() copies the ring oldest first into a preallocated buffer and a
+// background thread writes it to its own file, off the tick.
+//
+// Both files are a Header followed by `capacity` Records, native endian.
+// The oldest record is at head % capacity once head >= capacity, else 0.
+class FlightRecorder {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    enum Phase : uint8_t {
+        NETWORK,        // receive, timers, resends, session expiry
+        EVENTS,         // player inputs
+        SYSTEMS,
+        REPLICATION,    // removed / updated entities, game over checks
+        FLUSH,          // outboxes to the socket
+        PHASE_COUNT
+    };
+
+    enum Field : uint8_t {
+        MAP,
+        PLAYERS,
+        ENNEMIES,
+        PROJECTILES,
+        FIELD_COUNT
+    };
+
+    struct Header {
+        uint64_t magic = FLIGHT_MAGIC;
+        uint32_t version = FLIGHT_VERSION;
+        uint32_t record_size = 0;
+        uint32_t capacity = 0;
+        uint32_t budget_us = 0;
+        uint64_t head = 0;              // records written since start
+        int64_t origin_us = 0;          // unix time of Record::start_us 0
+        uint32_t over_budget = 0;       // ticks that were, dumped or not
+        uint8_t pad[20] = {};
+    };
+
+    struct Record {
+        uint64_t tick;
+        uint64_t start_us;              // since Header::origin_us
+        uint32_t total_ns;
+        uint32_t phase_ns[PHASE_COUNT];
+        uint16_t entities[FIELD_COUNT]; // per EntityField
+        uint32_t datagrams_in;
+        uint32_t datagrams_out;
+        uint32_t bytes_in;
+        uint32_t bytes_out;
+        uint32_t messages_out;
+        uint16_t sessions;
+        uint16_t spectators;
+        uint32_t reliable_pending;      // unacked messages, all sessions
+        uint32_t timers;
+        uint32_t arena_bytes;
+        uint8_t state;                  // Game::GAME_STATE
+        uint8_t pad[43];
+    };
+
+    // Falls back to anonymous memory when `path` cannot be mapped
+    FlightRecorder(const std::string& path, std::size_t capacity,
+        uint32_t budget_us);
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // Starts a tick, its record() is filled by the caller before end()
+    void begin(uint8_t state);
+    // Charges the time since the previous mark to `phase`
+    void lap(Phase phase);
+    // Closes the tick, true when it went over budget
+    bool end();
+
+    bool recording() const { return _recording; }
+    // The open tick, or the last one once end() returned
+    Record& record() { return *_current; }
+    bool persistent() const { return _file >= 0; }
+    std::size_t capacity() const { return _header->capacity; }
+    uint32_t budget() const { return _header->budget_us; }
+    // Where the ring left by a crashed run was moved, "" when there was none
+    const std::string& recovered() const { return _recovered; }
+
+    // Snapshots the ring and writes it in the background, returns the
+    // path or "" when the previous dump is still being written
+    std::string dump(const char* reason);
+
+ private:
+    std::string _path;
+    std::string _recovered;
+    int _file = -1;
+    std::size_t _length = 0;
+    Header* _header = nullptr;
+    Record* _records = nullptr;
+    Record* _current = nullptr;
+    bool _recording = false;
+    Clock::time_point _origin;
+    Clock::time_point _begin;
+    Clock::time_point _mark;
+
+    std::vector<uint8_t> _snapshot;     // sized once, reused by dump()
+    std::atomic<bool> _writing{false};
+    std::thread _writer;
+};
@@ -0,0 +1,83 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** IngressLimiter.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define HANDSHAKE_BUCKETS 4096     // power of two
+
+// Classes of client messages, each one has its own budget per session
+enum IngressClass : uint8_t {
+    INGRESS_SHOT = 0,   // PLAYER_SHOT
+    INGRESS_EVENT,      // CLIENT_EVENT
+    INGRESS_LINK,       // PING, PONG, ACK
+    INGRESS_CONTROL,    // handshake, WANT_START, RESYNC_REQUEST
+    INGRESS_COUNT,
+};
+
+// Refills `rate` tokens per second up to `burst`, a message costs one
+class TokenBucket {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    TokenBucket(float rate = 0.0f, float burst = 0.0f);
+
+    bool take(Clock::time_point now);
+
+ private:
+    float _rate;
+    float _burst;
+    float _tokens;
+    Clock::time_point _last;
+};
+
+// Per-session message budgets, checked before a packet is dispatched
+class IngressLimiter {
+ public:
+    struct Settings {
+        float shot_rate = 30.0f;        // messages per second
+        float shot_burst = 10.0f;
+        float event_rate = 120.0f;
+        float event_burst = 30.0f;
+        float link_rate = 60.0f;
+        float link_burst = 30.0f;
+        float control_rate = 4.0f;
+        float control_burst = 4.0f;
+        float handshake_rate = 2.0f;    // per source, senders without session
+        float handshake_burst = 8.0f;
+    };
+
+    explicit IngressLimiter(const Settings& settings);
+
+    bool allow(IngressClass cls, TokenBucket::Clock::time_point now) {
+        return _buckets[cls].take(now);
+    }
+
+ private:
+    std::array<TokenBucket, INGRESS_COUNT> _buckets;
+};
+
+// Budget of the senders without a session, one bucket per source address
+// so a flood from some sources does not lock the others out. Sources are
+// hashed with a per-process salt into a fixed table, memory stays bounded
+// whatever the number of (spoofed) sources.
+class HandshakeLimiter {
+ public:
+    explicit HandshakeLimiter(const IngressLimiter::Settings& settings);
+
+    bool allow(const std::string& source, TokenBucket::Clock::time_point now);
+
+ private:
+    uint64_t _salt;
+    std::vector<TokenBucket> _buckets;
+};
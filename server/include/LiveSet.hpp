@@ -0,0 +1,55 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** LiveSet.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <FrameArena.hpp>
+
+// Entities of one field that the clients were told about and simulate on
+// their own. The server only has to announce the ones that died (sweep)
+// or that no longer match what the clients simulate (changed), instead
+// of streaming the whole field.
+// Spawns and deaths are also published to listeners, so counters built on
+// top of it stay O(1) to query instead of rescanning the field.
+class LiveSet {
+ public:
+    using Listener = std::function<void(std::size_t entity)>;
+
+    LiveSet(std::size_t begin, std::size_t end);
+
+    // Spawn fires from add() for entities not already live, death from
+    // sweep(). clear() is a reset and fires nothing.
+    void onSpawn(Listener listener) { _onSpawn.push_back(listener); }
+    void onDeath(Listener listener) { _onDeath.push_back(listener); }
+
+    // `stamp` is any value that changes when the entity deviates from the
+    // client simulation, e.g. its health
+    void add(std::size_t entity, int64_t stamp = 0);
+    void clear();
+
+    // Forgets and returns the entities `alive` rejects
+    FrameVector<std::size_t> sweep(
+        const std::function<bool(std::size_t)>& alive, FrameArena& frame);
+    // Returns the entities whose stamp changed since the last call
+    FrameVector<std::size_t> changed(
+        const std::function<int64_t(std::size_t)>& stamp, FrameArena& frame);
+
+    std::size_t size() const { return _entities.size(); }
+
+ private:
+    std::size_t _begin;
+    std::vector<std::size_t> _entities;
+    std::vector<bool> _live;
+    std::vector<int64_t> _stamps;
+    std::vector<Listener> _onSpawn;
+    std::vector<Listener> _onDeath;
+};
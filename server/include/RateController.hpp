@@ -0,0 +1,52 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** RateController.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+enum SnapshotStream : uint8_t {
+    STREAM_PLAYERS = 0,
+    STREAM_ENNEMIES,
+    STREAM_PROJECTILES,
+    STREAM_COUNT,
+};
+
+struct RateSettings {
+    bool enabled = true;
+    float rtt_high = 150.0f;        // milliseconds
+    float rtt_low = 80.0f;          // milliseconds
+    float loss_high = 0.05f;        // ratio
+    float loss_low = 0.01f;         // ratio
+    std::size_t max_divider = 8;
+    std::size_t healthy_samples = 5;
+};
+
+// Per-client snapshot rate: a client with a bad link only receives one
+// snapshot out of `divider()`. The divider doubles when the link degrades
+// and is lowered by one after a run of healthy samples.
+class RateController {
+ public:
+    using Settings = RateSettings;
+
+    explicit RateController(const Settings& settings = Settings());
+
+    void onLinkSample(float rtt_ms, float loss);
+    bool due(SnapshotStream stream);
+
+    std::size_t divider() const { return _divider; }
+    void reset();
+
+ private:
+    Settings _settings;
+    std::size_t _divider = 1;
+    std::size_t _healthy = 0;
+    std::array<std::size_t, STREAM_COUNT> _skipped{};
+};
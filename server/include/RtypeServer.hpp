@@ -10,19 +10,36 @@
 
 #include <string>
 #include <cstdint>
+#include <random>
 #include <vector>
 #include <utility>
+#include <optional>
 #include <unordered_map>
 #include <network/GameServer.hpp>
 #include <GameTool.hpp>
+#include <clock.hpp>
 #include <Game.hpp>
 #include <Protocol.hpp>
+#include <Messages.hpp>
+#include <Snapshot.hpp>
+#include <PacketBundle.hpp>
+#include <ServerMetrics.hpp>
+#include <ServerConfig.hpp>
+#include <ClientSession.hpp>
+#include <RateController.hpp>
+#include <LiveSet.hpp>
+#include <CookieJar.hpp>
+#include <PacketCodec.hpp>
+#include <TimerWheel.hpp>
+#include <FrameArena.hpp>
+#include <FlightRecorder.hpp>
 
 class RtypeServer : public Game {
  public:
     RtypeServer(uint16_t port,
                 const std::string& protocol = "UDP",
-                size_t max_clients = 4);
+                size_t max_clients = 4,
+                const std::string& config_path = SERVER_CONFIG_PATH);
     ~RtypeServer();
 
     void run();
@@ -30,14 +47,11 @@ class RtypeServer : public Game {
     te::network::GameServer& getServer() { return _server; }
     size_t getClientCount() const { return _server.getClientCount(); }
 
-    #define UPDATES_TIME 10                 // milliseconds
-    #define TIME_ENNEMY_SPAWN 15            // seconds
-
-    #define REFRESH_PLAYERS_TIME 10         // milliseconds
-    #define REFRESH_ENNEMIES_TIME 500       // milliseconds
-    #define REFRESH_PROJECTILE_TIME 100     // milliseconds
+    const ServerConfig& getConfig() const { return _config; }
+    const LinkStats* getLinkStats(size_t entity) const;
 
  private:
+    ServerConfig _config;
     te::network::GameServer _server;
     uint16_t _port;
     std::string _protocol;
@@ -45,63 +59,163 @@ class RtypeServer : public Game {
 
     // next entities
     size_t _nextMapE = EntityField::MAP_BEGIN;
-    size_t _nextPlayerE = EntityField::PLAYER_BEGIN;
     size_t _nextEnnemyE = EntityField::ENEMIES_BEGIN;
     size_t _nextProjectileE = EntityField::PROJECTILES_BEGIN;
 
-    std::unordered_map<std::string, size_t> _client_entities;
-    std::unordered_map<size_t, te::event::Events> _entity_events;
+    std::unordered_map<std::string, ClientSession> _sessions;
+    // Player entities in use, released by removeSession
+    std::vector<bool> _playerSlots = std::vector<bool>(PLAYERS_FIELD_SIZE);
+    std::mt19937_64 _tokenRng{std::random_device{}()};
+    size_t _wavesSpawned = 0;
+    // Announced to the clients and not despawned yet
+    LiveSet _liveProjectiles{EntityField::PROJECTILES_BEGIN,
+        EntityField::PROJECTILES_END};
+    LiveSet _liveEnnemies{EntityField::ENEMIES_BEGIN,
+        EntityField::ENEMIES_END};
+    // Fed by the live set events, answer the game over checks in O(1)
+    std::vector<size_t> _ennemyWave;
+    std::vector<size_t> _waveAlive;
     float _state_broadcast_timer;
     std::vector<std::pair<size_t, PLAYER_STATE>> _players;
 
+    // spectators share a single outbox, filled once per tick
+    std::unordered_map<std::string, Spectator> _spectators;
+    PacketBundle _spectatorOutbox;
+
+    // budget of the senders that have no session yet, per source
+    HandshakeLimiter _handshakes;
+    // nothing is allocated for a sender before it echoes one of these
+    CookieJar _cookies;
+
+    // full-state packets above compression_threshold go through it
+    PacketCodec _codec;
+
+    // network metrics
+    ServerMetrics _metrics;
+
+    // Every timer of the session, advanced once per tick by update()
+    TimerWheel _timers;
+    std::vector<TimerWheel::Id> _projectileTimeouts;
+
+    // Latest input of each player slot, applied once per tick
+    std::vector<std::optional<te::event::Events>> _entity_events;
+    // Transient buffers, reset at the start of every tick by update().
+    // Outgoing packets are built in _packet and compressed into
+    // _compressed, both keep their capacity from tick to tick.
+    FrameArena _frame;
+    std::vector<uint8_t> _packet;
+    std::vector<uint8_t> _compressed;
+
+    // Last recorder_seconds of ticks, dumped on a hitch or on SIGUSR1
+    FlightRecorder _recorder;
+    ServerMetrics::Totals _recorded;    // totals at the previous tick
+    bool _dumpArmed = true;             // off during recorder_dump_cooldown
+
     bool start();
     void stop();
     void update(float delta_time);
+    // Ends the tick opened by update() once its outboxes are flushed
+    void closeTick();
+    void dumpFlight(const char* reason);
 
+    // Match lifecycle: lobby -> countdown -> in game -> results -> lobby
     void waitGame();
+    void countdownGame();
     void runGame();
+    void showResults();
     void resetGameState();
 
+    // Code -> handler, built at compile time, schemas in Messages.hpp
+    using Router = message::Router<RtypeServer, const net::Address&>;
+    static const Router::Table& routes();
     void registerProtocolHandlers();
+    // Size and rate checks run before dispatch, drops are only counted
+    bool admit(uint8_t code, const std::vector<uint8_t>& data,
+        const net::Address& sender);
     void generateMapBounds();
 
-    void sendConnectionAccepted(const net::Address& client, size_t entity_id);
+    void sendConnectionAccepted(ClientSession& session);
     void sendErrorTooManyClients(const net::Address& client);
-    void sendPong(const net::Address& client);
+    // Answers a request without a valid cookie, stores nothing
+    void sendChallenge(const net::Address& client);
+    // COMPRESSED version of the packet when it is big enough and shrinks
+    // The reference is `packet` or a buffer reused by the next call
+    const std::vector<uint8_t>& compress(const std::vector<uint8_t>& packet);
+    bool checkCookie(uint64_t cookie, const net::Address& sender);
+    void sendPings();
+    void sendPong(const net::Address& client,
+        const std::vector<uint8_t>& ping);
     void sendDisconnection(const net::Address& client);
     void sendEnnemiesData();
     void sendPlayersData();
     void sendProjectilesData();
+    // Projectiles and ennemies are replicated as events: a spawn (shot row
+    // or wave id), the ids of the dead ones once per tick, and for
+    // ennemies the rows of those that got hit. PROJECTILES_DATA and
+    // ENNEMIES_DATA are only slow correction streams.
+    void sendShotConfirmed(const ShotSnapshot& shot);
+    void sendRemoved(LiveSet& live, ProtocolCode code);
+    void sendEnnemiesUpdate();
+    void sendCountdown(uint32_t delay_ms);
     void sendGameStart();
+    void sendKeyframe(ClientSession& session);
     void sendEnnemySpawn(size_t waveNb);
 
-    void handleConnectionRequest(const std::vector<uint8_t>& data,
-                                  const net::Address& sender);
+    void handleConnectionRequest(const ConnectionRequest& msg,
+        const net::Address& sender);
     void handleDisconnection(const std::vector<uint8_t>& data,
                             const net::Address& sender);
     void handlePing(const std::vector<uint8_t>& data,
       const net::Address& sender);
     void handlePong(const std::vector<uint8_t>& data,
       const net::Address& sender);
+    void handleAck(const Ack& msg, const net::Address& sender);
+    void handleResyncRequest(const std::vector<uint8_t>& data,
+      const net::Address& sender);
+    void handleSpectate(const Spectate& msg, const net::Address& sender);
 
     void handleUserEvent(const std::vector<uint8_t>& data,
       const net::Address& sender);
     void handleWantStart(const std::vector<uint8_t>& data,
       const net::Address& sender);
+    void startCountdownIfReady();
 
-    void handleShoot(const std::vector<uint8_t>& data,
-      const net::Address& sender);
+    void handleShoot(const PlayerShot& msg, const net::Address& sender);
 
-    size_t spawnPlayerEntity(const net::Address& client);
+    // First free slot of the player field, none when it is full
+    std::optional<size_t> spawnPlayerEntity(const net::Address& client);
     void spawnEnnemyEntity(size_t waveNb);
 
+    // Subscribes counters and metrics to the live set spawn/death events
+    void trackLifecycle();
+    void scheduleSessionTimers();
+    void scheduleTimeout(size_t projectile, float seconds);
     void processEntitiesEvents();
     void checkGameOverConditions(bool lastWaveSpawned);
     void sendGameEnded(bool victory);
 
+    void queuePacket(const net::Address& client,
+        const std::vector<uint8_t>& packet);
+    // Control messages, resent until acked, see ReliableChannel.hpp
+    void queueReliable(ClientSession& session,
+        const std::vector<uint8_t>& packet);
+    void queueReliableBroadcast(const std::vector<uint8_t>& packet);
+    void resendReliable();
+    void queueSnapshot(SnapshotStream stream,
+        const std::vector<uint8_t>& packet);
+    void queueToSession(ClientSession& session,
+        const std::vector<uint8_t>& packet);
+    void flushSession(ClientSession& session);
+    void queueSpectators(const std::vector<uint8_t>& packet);
+    void flushSpectators();
+    void sendSpectatorKeyframe();
+    void flushOutbox();
+    ClientSession* findSession(const net::Address& addr);
+    ClientSession* reclaimSession(uint64_t token, const net::Address& addr);
+    void parkSession(const net::Address& addr);
+    void expireSessions();
+    void removeSession(const net::Address& addr);
+    void dumpMetrics();
+
     std::string addressToString(const net::Address& addr) const;
-    void append(std::vector<uint8_t>& vec, uint32_t value) const;
-    void append(std::vector<uint8_t>& vec, size_t value) const;
-    void append(std::vector<uint8_t>& vec, int64_t value) const;
-    void append(std::vector<uint8_t>& vec, float value) const;
 };
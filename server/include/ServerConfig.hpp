@@ -0,0 +1,65 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** ServerConfig.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <PacketBundle.hpp>
+#include <LinkStats.hpp>
+#include <ReliableChannel.hpp>
+#include <PacketCodec.hpp>
+#include <RateController.hpp>
+#include <IngressLimiter.hpp>
+#include <ServerMetrics.hpp>
+
+#define SERVER_CONFIG_PATH "config/server.toml"
+
+// Runtime server settings, read from a flat TOML file
+// (`[section]` headers and `key = number` / `key = true` lines)
+struct ServerConfig {
+    // [rates]
+    float updates_time = 10.0f;             // milliseconds
+    float ennemy_spawn_time = 15.0f;        // seconds
+    float refresh_players_time = 10.0f;     // milliseconds
+    float refresh_ennemies_time = 5000.0f;  // milliseconds
+    float refresh_projectiles_time = 2000.0f;  // milliseconds
+
+    // [network]
+    std::size_t bundle_max_size = BUNDLE_MAX_SIZE;
+    float metrics_dump_time = METRICS_DUMP_TIME;  // seconds
+    float ping_interval = 1000.0f;          // milliseconds
+    float ping_timeout = PING_TIMEOUT;      // milliseconds
+    float reliable_resend_time = RELIABLE_RESEND_TIME;  // milliseconds
+    float reliable_stall_time = RELIABLE_STALL_TIME;    // milliseconds
+    float session_grace_time = 10.0f;       // seconds
+    std::size_t compression_threshold = COMPRESSION_THRESHOLD;  // 0 = off
+
+    // [adaptive]
+    RateController::Settings adaptive;
+
+    // [ingress]
+    IngressLimiter::Settings ingress;
+
+    // [spectators]
+    std::size_t max_spectators = 32;
+    float spectator_keyframe_time = 2.0f;   // seconds
+
+    // [lifecycle]
+    float countdown_time = 3.0f;            // seconds, lobby -> in game
+    float results_time = 5.0f;              // seconds, results -> lobby
+
+    // [recorder]
+    float recorder_seconds = 30.0f;         // history kept by the ring
+    float recorder_budget_time = 0.0f;      // milliseconds, 0 = updates_time
+    float recorder_dump_cooldown = 30.0f;   // seconds between budget dumps
+
+    bool load(const std::string& path);
+    static ServerConfig fromFile(const std::string& path);
+};
@@ -0,0 +1,60 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** ServerMetrics.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+#define METRICS_DUMP_TIME 10            // seconds
+
+// Network counters over one dump window, reset after every dump
+struct ServerMetrics {
+    uint64_t ticks = 0;
+    uint64_t datagrams_out = 0;     // one sendto per datagram per recipient
+    uint64_t datagrams_in = 0;      // one recvfrom per datagram
+    uint64_t bytes_out = 0;
+    uint64_t bytes_in = 0;
+    uint64_t messages_out = 0;      // protocol messages, bundled or not
+    uint64_t dropped_size = 0;      // payload size invalid for its code
+    uint64_t dropped_unknown = 0;   // needs a session, sender has none
+    uint64_t dropped_limited = 0;   // over the sender's token bucket
+    uint64_t challenges = 0;        // handshakes answered with a cookie
+    uint64_t ennemies_down = 0;     // despawns seen by the live sets
+    uint64_t projectiles_down = 0;
+
+    // Per compressed packet code, to decide per stream if it pays off
+    struct Compression {
+        uint64_t packets = 0;
+        uint64_t bytes_in = 0;
+        uint64_t bytes_out = 0;     // equals bytes_in when it did not shrink
+        uint64_t micros = 0;        // time spent in the codec
+    };
+    std::map<uint8_t, Compression> compression;
+
+    // Kept across reset(), the flight recorder diffs them every tick
+    struct Totals {
+        uint64_t datagrams_out = 0;
+        uint64_t datagrams_in = 0;
+        uint64_t bytes_out = 0;
+        uint64_t bytes_in = 0;
+        uint64_t messages_out = 0;
+    };
+    Totals totals;
+
+    void onTick() { ticks++; }
+    void onCompress(uint8_t code, std::size_t in, std::size_t out,
+        uint64_t micros);
+    void onSend(std::size_t bytes, std::size_t recipients,
+        std::size_t messages = 1);
+    void onReceive(std::size_t bytes);
+
+    double syscallsPerTick() const;
+    void reset();
+};
@@ -0,0 +1,100 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** CookieJar.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <CookieJar.hpp>
+
+static uint64_t rotl(uint64_t x, int b) {
+    return (x << b) | (x >> (64 - b));
+}
+
+static void sipRound(uint64_t v[4]) {
+    v[0] += v[1];
+    v[1] = rotl(v[1], 13);
+    v[1] ^= v[0];
+    v[0] = rotl(v[0], 32);
+    v[2] += v[3];
+    v[3] = rotl(v[3], 16);
+    v[3] ^= v[2];
+    v[0] += v[3];
+    v[3] = rotl(v[3], 21);
+    v[3] ^= v[0];
+    v[2] += v[1];
+    v[1] = rotl(v[1], 17);
+    v[1] ^= v[2];
+    v[2] = rotl(v[2], 32);
+}
+
+// SipHash-2-4, message words are read little endian as the spec says,
+// whatever the host. Only the resulting u64 goes on the wire.
+static uint64_t sipHash(const uint64_t key[2], const uint8_t* data,
+    std::size_t size) {
+    uint64_t v[4] = {
+        key[0] ^ 0x736f6d6570736575ULL, key[1] ^ 0x646f72616e646f6dULL,
+        key[0] ^ 0x6c7967656e657261ULL, key[1] ^ 0x7465646279746573ULL};
+    std::size_t full = size - size % 8;
+    uint64_t m;
+
+    for (std::size_t i = 0; i < full; i += 8) {
+        m = 0;
+        for (std::size_t b = 0; b < 8; ++b)
+            m |= static_cast<uint64_t>(data[i + b]) << (8 * b);
+        v[3] ^= m;
+        sipRound(v);
+        sipRound(v);
+        v[0] ^= m;
+    }
+    m = static_cast<uint64_t>(size) << 56;
+    for (std::size_t i = 0; i < size % 8; ++i)
+        m |= static_cast<uint64_t>(data[full + i]) << (8 * i);
+    v[3] ^= m;
+    sipRound(v);
+    sipRound(v);
+    v[0] ^= m;
+    v[2] ^= 0xff;
+    for (int i = 0; i < 4; ++i)
+        sipRound(v);
+    return v[0] ^ v[1] ^ v[2] ^ v[3];
+}
+
+CookieJar::CookieJar() {
+    std::random_device rd;
+
+    for (uint64_t& k : _key)
+        k = (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
+uint64_t CookieJar::issue(const std::string& addr,
+    Clock::time_point now) const {
+    return make(addr, window(now));
+}
+
+bool CookieJar::check(uint64_t cookie, const std::string& addr,
+    Clock::time_point now) const {
+    uint64_t current = window(now);
+
+    return cookie == make(addr, current)
+        || (current > 0 && cookie == make(addr, current - 1));
+}
+
+uint64_t CookieJar::make(const std::string& addr, uint64_t window) const {
+    std::string message(reinterpret_cast<const char*>(&window),
+        sizeof(uint64_t));
+
+    message += addr;
+    uint64_t cookie = sipHash(_key,
+        reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    return cookie == 0 ? 1 : cookie;  // 0 means "no cookie" on the wire
+}
+
+uint64_t CookieJar::window(Clock::time_point now) {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        now.time_since_epoch()).count() / COOKIE_LIFETIME;
+}
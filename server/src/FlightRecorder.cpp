@@ -0,0 +1,177 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** FlightRecorder.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <string>
+#include <thread>
+#include <Logger.hpp>
+#include <FlightRecorder.hpp>
+
+static_assert(sizeof(FlightRecorder::Header) == 64);
+static_assert(sizeof(FlightRecorder::Record) == 128);
+
+static uint32_t nanos(FlightRecorder::Clock::duration elapsed) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        elapsed).count();
+    return static_cast<uint32_t>(std::clamp<int64_t>(ns, 0,
+        std::numeric_limits<uint32_t>::max()));
+}
+
+static std::string dumpPath(const char* reason) {
+    return FLIGHT_DUMP_PREFIX + std::to_string(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count())
+        + "-" + reason + ".rec";
+}
+
+// A ring that recorded at least one tick, left by a run that did not
+// shut down cleanly
+static bool hasRecording(const std::string& path) {
+    FlightRecorder::Header header;
+    int file = open(path.c_str(), O_RDONLY);
+
+    if (file < 0)
+        return false;
+    bool read_ok = read(file, &header, sizeof(header)) == sizeof(header);
+    close(file);
+    return read_ok && header.magic == FLIGHT_MAGIC &&
+        header.version == FLIGHT_VERSION && header.head > 0;
+}
+
+FlightRecorder::FlightRecorder(const std::string& path, std::size_t capacity,
+    uint32_t budget_us) : _path(path) {
+    capacity = std::max<std::size_t>(capacity, 1);
+    if (hasRecording(path)) {
+        std::string moved = dumpPath("crash");
+        if (std::rename(path.c_str(), moved.c_str()) == 0)
+            _recovered = moved;
+    }
+    _length = sizeof(Header) + capacity * sizeof(Record);
+
+    void* map = MAP_FAILED;
+    _file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (_file >= 0 && ftruncate(_file, _length) == 0)
+        map = mmap(nullptr, _length, PROT_READ | PROT_WRITE, MAP_SHARED,
+            _file, 0);
+    if (map == MAP_FAILED) {
+        if (_file >= 0)
+            close(_file);
+        _file = -1;
+        map = mmap(nullptr, _length, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (map == MAP_FAILED)
+        throw std::bad_alloc();
+    // Touches every page now rather than on the first laps
+    std::memset(map, 0, _length);
+
+    _header = new (map) Header();
+    _header->record_size = sizeof(Record);
+    _header->capacity = static_cast<uint32_t>(capacity);
+    _header->budget_us = budget_us;
+    _header->origin_us = std::chrono::duration_cast<
+        std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    _origin = Clock::now();
+    _records = reinterpret_cast<Record*>(
+        static_cast<uint8_t*>(map) + sizeof(Header));
+    _current = _records;
+    _snapshot.reserve(_length);
+}
+
+FlightRecorder::~FlightRecorder() {
+    if (_writer.joinable())
+        _writer.join();
+    munmap(_header, _length);
+    if (_file < 0)
+        return;
+    close(_file);
+    // Only a crash leaves the ring behind
+    unlink(_path.c_str());
+}
+
+void FlightRecorder::begin(uint8_t state) {
+    _begin = Clock::now();
+    _mark = _begin;
+    _current = &_records[_header->head % _header->capacity];
+    *_current = Record{};
+    _current->tick = _header->head;
+    _current->start_us = std::chrono::duration_cast<
+        std::chrono::microseconds>(_begin - _origin).count();
+    _current->state = state;
+    _recording = true;
+}
+
+void FlightRecorder::lap(Phase phase) {
+    if (!_recording)
+        return;
+    auto now = Clock::now();
+
+    _current->phase_ns[phase] += nanos(now - _mark);
+    _mark = now;
+}
+
+bool FlightRecorder::end() {
+    if (!_recording)
+        return false;
+    _current->total_ns = nanos(Clock::now() - _begin);
+    _recording = false;
+    // Only counted once complete, a crash mid-tick leaves it out
+    _header->head++;
+
+    if (_header->budget_us == 0 ||
+        _current->total_ns / 1000 <= _header->budget_us)
+        return false;
+    _header->over_budget++;
+    return true;
+}
+
+std::string FlightRecorder::dump(const char* reason) {
+    if (_writing)
+        return "";
+    if (_writer.joinable())
+        _writer.join();
+
+    std::size_t capacity = _header->capacity;
+    std::size_t count = std::min<uint64_t>(_header->head, capacity);
+    std::size_t oldest = _header->head >= capacity
+        ? _header->head % capacity : 0;
+    std::string path = dumpPath(reason);
+
+    // Same layout, unrolled so that the oldest record comes first
+    Header header = *_header;
+    header.capacity = static_cast<uint32_t>(count);
+    header.head = count;
+    _snapshot.resize(sizeof(Header) + count * sizeof(Record));
+    uint8_t* out = _snapshot.data();
+    std::memcpy(out, &header, sizeof(Header));
+    out += sizeof(Header);
+    std::memcpy(out, _records + oldest, (count - oldest) * sizeof(Record));
+    out += (count - oldest) * sizeof(Record);
+    std::memcpy(out, _records, oldest * sizeof(Record));
+
+    _writing = true;
+    _writer = std::thread([this, path]() {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(_snapshot.data()),
+            _snapshot.size());
+        if (!file)
+            LOG_ERROR("Server", "Flight recorder dump failed",
+                {{"path", path}});
+        _writing = false;
+    });
+    return path;
+}
@@ -0,0 +1,48 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** IngressLimiter.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <IngressLimiter.hpp>
+
+TokenBucket::TokenBucket(float rate, float burst)
+    : _rate(rate), _burst(burst), _tokens(burst), _last(Clock::now()) {}
+
+bool TokenBucket::take(Clock::time_point now) {
+    float elapsed = std::chrono::duration<float>(now - _last).count();
+
+    _last = now;
+    _tokens = std::min(_burst, _tokens + elapsed * _rate);
+    if (_tokens < 1.0f)
+        return false;
+    _tokens -= 1.0f;
+    return true;
+}
+
+IngressLimiter::IngressLimiter(const Settings& settings)
+    : _buckets{
+        TokenBucket(settings.shot_rate, settings.shot_burst),
+        TokenBucket(settings.event_rate, settings.event_burst),
+        TokenBucket(settings.link_rate, settings.link_burst),
+        TokenBucket(settings.control_rate, settings.control_burst)} {}
+
+HandshakeLimiter::HandshakeLimiter(const IngressLimiter::Settings& settings)
+    : _salt(std::random_device{}())
+    , _buckets(HANDSHAKE_BUCKETS,
+        TokenBucket(settings.handshake_rate, settings.handshake_burst)) {}
+
+bool HandshakeLimiter::allow(const std::string& source,
+    TokenBucket::Clock::time_point now) {
+    uint64_t h = (std::hash<std::string>{}(source) ^ _salt)
+        * 0x9e3779b97f4a7c15ULL;
+
+    return _buckets[(h >> 32) & (HANDSHAKE_BUCKETS - 1)].take(now);
+}
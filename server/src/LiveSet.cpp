@@ -0,0 +1,68 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** LiveSet.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <LiveSet.hpp>
+
+LiveSet::LiveSet(std::size_t begin, std::size_t end)
+    : _begin(begin), _live(end - begin, false), _stamps(end - begin, 0) {}
+
+void LiveSet::add(std::size_t entity, int64_t stamp) {
+    std::size_t slot = entity - _begin;
+
+    if (entity < _begin || slot >= _live.size())
+        return;
+    _stamps[slot] = stamp;
+    if (_live[slot])
+        return;
+    _live[slot] = true;
+    _entities.push_back(entity);
+    for (auto& listener : _onSpawn)
+        listener(entity);
+}
+
+void LiveSet::clear() {
+    _entities.clear();
+    std::fill(_live.begin(), _live.end(), false);
+}
+
+FrameVector<std::size_t> LiveSet::sweep(
+    const std::function<bool(std::size_t)>& alive, FrameArena& frame) {
+    FrameVector<std::size_t> dead(frame);
+
+    auto end = std::remove_if(_entities.begin(), _entities.end(),
+        [&](std::size_t entity) {
+            if (alive(entity))
+                return false;
+            _live[entity - _begin] = false;
+            dead.push_back(entity);
+            return true;
+        });
+    _entities.erase(end, _entities.end());
+    for (std::size_t entity : dead) {
+        for (auto& listener : _onDeath)
+            listener(entity);
+    }
+    return dead;
+}
+
+FrameVector<std::size_t> LiveSet::changed(
+    const std::function<int64_t(std::size_t)>& stamp, FrameArena& frame) {
+    FrameVector<std::size_t> moved(frame);
+
+    for (std::size_t entity : _entities) {
+        int64_t value = stamp(entity);
+        if (value == _stamps[entity - _begin])
+            continue;
+        _stamps[entity - _begin] = value;
+        moved.push_back(entity);
+    }
+    return moved;
+}
@@ -0,0 +1,44 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** RateController.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+
+#include <RateController.hpp>
+
+RateController::RateController(const Settings& settings)
+    : _settings(settings) {}
+
+void RateController::onLinkSample(float rtt_ms, float loss) {
+    if (!_settings.enabled)
+        return;
+
+    if (rtt_ms > _settings.rtt_high || loss > _settings.loss_high) {
+        _divider = std::min(_divider * 2, _settings.max_divider);
+        _healthy = 0;
+    } else if (rtt_ms < _settings.rtt_low && loss < _settings.loss_low) {
+        if (++_healthy >= _settings.healthy_samples && _divider > 1) {
+            _divider--;
+            _healthy = 0;
+        }
+    } else {
+        _healthy = 0;
+    }
+}
+
+bool RateController::due(SnapshotStream stream) {
+    if (++_skipped[stream] < _divider)
+        return false;
+    _skipped[stream] = 0;
+    return true;
+}
+
+void RateController::reset() {
+    _divider = 1;
+    _healthy = 0;
+    _skipped.fill(0);
+}
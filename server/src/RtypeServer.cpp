@@ -12,9 +12,9 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
-#include <iostream>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <utility>
 #include <sstream>
 #include <csignal>
@@ -31,22 +31,46 @@
 #include <Game.hpp>
 #include <clock.hpp>
 
+#include <Snapshot.hpp>
 #include <waves.hpp>
+#include <Logger.hpp>
 #include <RtypeServer.hpp>
 
-// Global flag for signal handling
+// Global flags for signal handling
 static std::atomic<bool> g_running(true);
+static std::atomic<bool> g_dumpFlight(false);
 
 RtypeServer::RtypeServer(uint16_t port,
                          const std::string& protocol,
-                         size_t max_clients)
+                         size_t max_clients,
+                         const std::string& config_path)
     : Game("./server/plugins")
+    , _config(ServerConfig::fromFile(config_path))
     , _server(port, protocol)
     , _port(port)
     , _protocol(protocol)
     , _max_clients(max_clients)
-    , _state_broadcast_timer(0.0f) {
+    , _state_broadcast_timer(0.0f)
+    , _spectatorOutbox(_config.bundle_max_size)
+    , _handshakes(_config.ingress)
+    , _timers(_config.updates_time / 1000.0f)
+    , _projectileTimeouts(PROJECTILES_FIELD_SIZE, 0)
+    , _entity_events(PLAYERS_FIELD_SIZE)
+    , _recorder(FLIGHT_RECORDER_PATH, static_cast<size_t>(
+        _config.recorder_seconds * 1000.0f / _config.updates_time),
+        static_cast<uint32_t>(1000.0f * (_config.recorder_budget_time > 0
+            ? _config.recorder_budget_time : _config.updates_time))) {
     registerProtocolHandlers();
+    trackLifecycle();
+    scheduleSessionTimers();
+    LOG_INFO("Server", "Flight recorder", {{"path", FLIGHT_RECORDER_PATH},
+        {"ticks", _recorder.capacity()}, {"mapped", _recorder.persistent()}});
+    if (!_recorder.recovered().empty())
+        LOG_WARN("Server", "Previous run did not shut down, ring kept",
+            {{"path", _recorder.recovered()}});
+    if (_codec.loadDictionary())
+        LOG_INFO("Server", "Compression dictionary loaded",
+            {{"path", COMPRESSION_DICT}});
 
     addConfig("config/entities/player.toml");
     addConfig("config/entities/enemy1.toml");
@@ -63,35 +87,16 @@ RtypeServer::RtypeServer(uint16_t port,
     createSystem("kill_entity");
 
     _server.setClientConnectCallback([this](const net::Address& client) {
-        std::cout << "[Server] Network connection from: "
-                  << client.getIP() << ":" << client.getPort() << "\n";
+        LOG_DEBUG("Server", "Network connection",
+            {{"addr", addressToString(client)}});
     });
 
     _server.setClientDisconnectCallback([this](const net::Address& client) {
-        std::cout << "[Server] Client disconnected: "
-                  << client.getIP() << ":" << client.getPort()
-                  << " (clients left: " << _server.getClientCount() << ")"
-                  << "\n";
-
-        std::string addr_key = addressToString(client);
-        auto it = _client_entities.find(addr_key);
-        if (it != _client_entities.end()) {
-            size_t entity_id = it->second;
-            std::cout << "[Server] Removing disconnected client's entity "
-                << entity_id << "\n";
-
-            auto player_it = std::find_if(_players.begin(), _players.end(),
-                [entity_id](const std::pair<size_t, PLAYER_STATE>& p) {
-                    return p.first == entity_id;
-                });
-            if (player_it != _players.end()) {
-                std::cout << "[Server] Removing player " << entity_id <<
-                " from players list\n";
-                _players.erase(player_it);
-            }
-            removeEntity(entity_id);
-            _client_entities.erase(it);
-        }
+        LOG_INFO("Server", "Client connection lost",
+            {{"addr", addressToString(client)},
+            {"clients_left", _server.getClientCount()}});
+        if (_spectators.erase(addressToString(client)) == 0)
+            parkSession(client);
     });
 }
 
@@ -100,148 +105,179 @@ RtypeServer::~RtypeServer() {
 }
 
 void signalHandler(int signal) {
-    if (signal == SIGINT || signal == SIGTERM) {
-        std::cout << "\n[Server] Shutting down gracefully..." << std::endl;
+    if (signal == SIGINT || signal == SIGTERM)
         g_running = false;
-    }
+    if (signal == SIGUSR1)
+        g_dumpFlight = true;
 }
 
 void RtypeServer::run() {
-    std::cout << "=== R-Type Server ===" << std::endl;
-    std::cout << "Port: " << _port << std::endl;
-    std::cout << "Protocol: " << _protocol << std::endl;
-    std::cout << "Max clients: " << _max_clients << std::endl;
-    std::cout << "=====================" << std::endl;
+    LOG_INFO("Server", "R-Type Server", {{"port", _port},
+        {"protocol", _protocol}, {"max_clients", _max_clients}});
 
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
+    std::signal(SIGUSR1, signalHandler);
 
     try {
         if (!start()) {
-            std::cerr << "[Server] Failed to start server on port "
-                << _port << std::endl;
+            LOG_ERROR("Server", "Failed to start server", {{"port", _port}});
             return;
         }
 
-        std::cout << "[Server] Server started successfully!" << std::endl;
-        std::cout << "[Server] Waiting for players to connect and ready up..."
-            << std::endl;
-        std::cout << "[Server] Press Ctrl+C to stop" << std::endl;
+        LOG_INFO("Server", "Server started, waiting for players to ready up"
+            " (Ctrl+C to stop)");
 
         while (g_running) {
-            if (getGameState() == GAME_WAITING) {
-                waitGame();
-            } else if (getGameState() == IN_GAME) {
-                runGame();
-            } else if (getGameState() == GAME_ENDED) {
-                std::cout << "[Server] Game ended!" << std::endl;
-                break;
+            switch (getGameState()) {
+                case GAME_WAITING: waitGame(); break;
+                case GAME_COUNTDOWN: countdownGame(); break;
+                case IN_GAME: runGame(); break;
+                case GAME_ENDED: showResults(); break;
             }
         }
 
-        std::cout << "[Server] Stopping server..." << std::endl;
+        if (!g_running)
+            LOG_INFO("Server", "Shutting down gracefully...");
+        LOG_INFO("Server", "Stopping server...");
         stop();
-        std::cout << "[Server] Server stopped. Goodbye!" << std::endl;
+        LOG_INFO("Server", "Server stopped. Goodbye!");
     } catch (const std::exception& e) {
-        std::cerr << "[Server] Fatal error: " << e.what() << std::endl;
+        LOG_ERROR("Server", "Fatal error", {{"what", e.what()}});
         return;
     }
 }
 
 void RtypeServer::waitGame() {
-    te::Timestamp updateTimer(UPDATES_TIME / 1000.0f);
+    te::Timestamp updateTimer(_config.updates_time / 1000.0f);
 
     while (g_running && getGameState() == GAME_WAITING) {
         if (updateTimer.checkDelay()) {
             update(0.0f);
         }
+        flushOutbox();
+        closeTick();
     }
 }
 
-void RtypeServer::resetGameState() {
-    std::cout << "[Server] Resetting game state..." << std::endl;
+void RtypeServer::countdownGame() {
+    te::Timestamp updateTimer(_config.updates_time / 1000.0f);
+    auto countdown = _timers.after(_config.countdown_time, [this]() {
+        for (auto& player : _players)
+            player.second = PLAYER_ALIVE;
+        setGameState(IN_GAME);
+        sendGameStart();
+    });
 
-    for (auto& [entity_id, state] : _players) {
-        state = WAIT_GAME;
+    sendCountdown(static_cast<uint32_t>(_config.countdown_time * 1000.0f));
+    while (g_running && getGameState() == GAME_COUNTDOWN) {
+        if (updateTimer.checkDelay())
+            update(0.0f);
+        if (_players.empty() && getGameState() == GAME_COUNTDOWN) {
+            LOG_INFO("Server", "Lobby emptied during countdown");
+            setGameState(GAME_WAITING);
+        }
+        flushOutbox();
+        closeTick();
     }
+    _timers.cancel(countdown);
+}
 
-    for (ECS::Entity e = EntityField::ENEMIES_BEGIN;
-         e < EntityField::ENEMIES_END; ++e) {
-        removeEntity(e);
-    }
+void RtypeServer::showResults() {
+    te::Timestamp updateTimer(_config.updates_time / 1000.0f);
+    auto results = _timers.after(_config.results_time, [this]() {
+        resetGameState();
+        setGameState(GAME_WAITING);
+        LOG_INFO("Server", "Back to lobby", {{"players", _players.size()}});
+        startCountdownIfReady();
+    });
 
-    for (ECS::Entity e = EntityField::PROJECTILES_BEGIN;
-         e < EntityField::PROJECTILES_END; ++e) {
-        removeEntity(e);
+    while (g_running && getGameState() == GAME_ENDED) {
+        if (updateTimer.checkDelay())
+            update(0.0f);
+        flushOutbox();
+        closeTick();
     }
+    _timers.cancel(results);
+}
 
-    for (ECS::Entity e = EntityField::MAP_BEGIN;
-         e < EntityField::MAP_END; ++e) {
-        removeEntity(e);
-    }
+void RtypeServer::resetGameState() {
+    auto begin = std::chrono::steady_clock::now();
 
     for (auto& [entity_id, state] : _players) {
-        removeEntity(entity_id);
-        createEntity(entity_id, "player");
+        if (state != READY_TO_START)
+            state = WAIT_GAME;
     }
+    restoreBaseline();
 
     _nextMapE = EntityField::MAP_BEGIN;
     _nextEnnemyE = EntityField::ENEMIES_BEGIN;
     _nextProjectileE = EntityField::PROJECTILES_BEGIN;
+    _wavesSpawned = 0;
+    for (auto& timeout : _projectileTimeouts) {
+        _timers.cancel(timeout);
+        timeout = 0;
+    }
+    _liveProjectiles.clear();
+    _liveEnnemies.clear();
+    std::fill(_waveAlive.begin(), _waveAlive.end(), 0);
 
-    _entity_events.clear();
+    for (auto& events : _entity_events)
+        events.reset();
 
-    std::cout << "[Server] Game state reset complete!" << std::endl;
+    LOG_INFO("Server", "Game state reset", {{"players", _players.size()},
+        {"us", std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count()}});
 }
 
 void RtypeServer::runGame() {
-    te::Timestamp updateTimer(UPDATES_TIME / 1000.0f);
-    te::Timestamp ennemyWaveTimer(static_cast<float>(TIME_ENNEMY_SPAWN));
-    te::Timestamp playersUpdateTimer(REFRESH_PLAYERS_TIME / 1000.0f);
-    te::Timestamp ennemiesUpdateTimer(REFRESH_ENNEMIES_TIME / 1000.0f);
-    te::Timestamp projectileUpdateTimer(REFRESH_PROJECTILE_TIME / 1000.0f);
-    uint waveNb = 0;
+    te::Timestamp updateTimer(_config.updates_time / 1000.0f);
+    size_t waveNb = 0;
     bool lastWaveSpawned = false;
 
-    std::cout << "[Server] Game started! Running game loop..." << std::endl;
+    LOG_INFO("Server", "Game started, running game loop");
 
     _nextMapE = createBoundaries(_nextMapE);
     spawnEnnemyEntity(waveNb);
 
-    while (g_running && getGameState() == IN_GAME) {
-        if (getGameState() != IN_GAME)
-            break;
+    // Cancelled below, the callbacks never outlive the locals they capture
+    std::vector<TimerWheel::Id> timers = {
+        _timers.every(_config.refresh_players_time / 1000.0f,
+            [this]() { sendPlayersData(); }),
+        _timers.every(_config.refresh_ennemies_time / 1000.0f,
+            [this]() { sendEnnemiesData(); }),
+        _timers.every(_config.refresh_projectiles_time / 1000.0f,
+            [this]() { sendProjectilesData(); }),
+        _timers.every(_config.ennemy_spawn_time, [&]() {
+            if (lastWaveSpawned)
+                return;
+            if (++waveNb >= NB_WAVES)
+                lastWaveSpawned = true;
+            else
+                spawnEnnemyEntity(waveNb);
+        }),
+    };
 
+    while (g_running && getGameState() == IN_GAME) {
         if (updateTimer.checkDelay()) {
             update(0.0f);
             processEntitiesEvents();
+            _recorder.lap(FlightRecorder::EVENTS);
             runSystems();
+            _recorder.lap(FlightRecorder::SYSTEMS);
+            sendRemoved(_liveProjectiles, PROJECTILES_REMOVED);
+            sendRemoved(_liveEnnemies, ENNEMIES_REMOVED);
+            sendEnnemiesUpdate();
 
             checkGameOverConditions(lastWaveSpawned);
+            _recorder.lap(FlightRecorder::REPLICATION);
         }
-
-        if (playersUpdateTimer.checkDelay()) {
-            sendPlayersData();
-        }
-
-        if (ennemiesUpdateTimer.checkDelay()) {
-            sendEnnemiesData();
-        }
-
-        if (projectileUpdateTimer.checkDelay()) {
-            sendProjectilesData();
-        }
-
-        if (ennemyWaveTimer.checkDelay()) {
-            waveNb++;
-            if (waveNb >= NB_WAVES) {
-                lastWaveSpawned = true;
-            } else {
-                spawnEnnemyEntity(waveNb);
-            }
-        }
+        flushOutbox();
+        closeTick();
     }
-    std::cout << "[Server] Game loop ended." << std::endl;
+    for (auto id : timers)
+        _timers.cancel(id);
+    LOG_INFO("Server", "Game loop ended");
 }
 
 bool RtypeServer::start() {
@@ -253,185 +289,637 @@ void RtypeServer::stop() {
 }
 
 void RtypeServer::update(float delta_time) {
+    _recorder.begin(getGameState());
     _server.update(delta_time);
-    if (getGameState() != IN_GAME)
+    _frame.reset();
+    _metrics.onTick();
+    _timers.advance();
+    resendReliable();
+    expireSessions();
+    _recorder.lap(FlightRecorder::NETWORK);
+}
+
+void RtypeServer::closeTick() {
+    if (g_dumpFlight.exchange(false))
+        dumpFlight("signal");
+    if (!_recorder.recording())
+        return;
+    _recorder.lap(FlightRecorder::FLUSH);
+
+    auto& record = _recorder.record();
+    const auto& totals = _metrics.totals;
+    record.entities[FlightRecorder::MAP] = _nextMapE - EntityField::MAP_BEGIN;
+    record.entities[FlightRecorder::PLAYERS] = _players.size();
+    record.entities[FlightRecorder::ENNEMIES] = _liveEnnemies.size();
+    record.entities[FlightRecorder::PROJECTILES] = _liveProjectiles.size();
+    record.datagrams_in = totals.datagrams_in - _recorded.datagrams_in;
+    record.datagrams_out = totals.datagrams_out - _recorded.datagrams_out;
+    record.bytes_in = totals.bytes_in - _recorded.bytes_in;
+    record.bytes_out = totals.bytes_out - _recorded.bytes_out;
+    record.messages_out = totals.messages_out - _recorded.messages_out;
+    _recorded = totals;
+    record.sessions = _sessions.size();
+    record.spectators = _spectators.size();
+    for (const auto& [key, session] : _sessions)
+        record.reliable_pending += session.reliable.pending();
+    record.timers = _timers.size();
+    record.arena_bytes = _frame.used();
+
+    if (_recorder.end() && _dumpArmed)
+        dumpFlight("budget");
+}
+
+void RtypeServer::dumpFlight(const char* reason) {
+    std::string path = _recorder.dump(reason);
+    if (path.empty()) {
+        LOG_WARN("Server", "Flight recorder still writing, dump skipped",
+            {{"reason", reason}});
         return;
+    }
+    LOG_WARN("Server", "Flight recorder dumping", {{"reason", reason},
+        {"path", path}, {"budget_us", _recorder.budget()},
+        {"last_tick_us", _recorder.record().total_ns / 1000}});
+
+    // A hitch tends to come with more, one dump covers them
+    _dumpArmed = false;
+    _timers.after(_config.recorder_dump_cooldown,
+        [this]() { _dumpArmed = true; });
+}
+
+void RtypeServer::scheduleSessionTimers() {
+    _timers.every(_config.ping_interval / 1000.0f,
+        [this]() { sendPings(); });
+    _timers.every(_config.metrics_dump_time, [this]() { dumpMetrics(); });
+    _timers.every(_config.spectator_keyframe_time, [this]() {
+        if (!_spectators.empty())
+            sendSpectatorKeyframe();
+    });
+}
+
+void RtypeServer::scheduleTimeout(size_t projectile, float seconds) {
+    size_t slot = projectile - EntityField::PROJECTILES_BEGIN;
+
+    _timers.cancel(_projectileTimeouts[slot]);
+    // The death listener drops it if the projectile is gone before that
+    _projectileTimeouts[slot] = _timers.after(seconds,
+        [this, projectile]() { removeEntity(projectile); });
+}
+
+const RtypeServer::Router::Table& RtypeServer::routes() {
+    static constexpr Router::Table ROUTES = Router::table({
+        Router::typed<ConnectionRequest,
+            &RtypeServer::handleConnectionRequest>(),
+        Router::raw<&RtypeServer::handleDisconnection>(DISCONNECTION),
+        Router::raw<&RtypeServer::handlePing>(PING),
+        Router::raw<&RtypeServer::handlePong>(PONG),
+        Router::typed<Ack, &RtypeServer::handleAck>(),
+        Router::raw<&RtypeServer::handleResyncRequest>(RESYNC_REQUEST),
+        Router::typed<Spectate, &RtypeServer::handleSpectate>(),
+        Router::raw<&RtypeServer::handleUserEvent>(CLIENT_EVENT),
+        Router::raw<&RtypeServer::handleWantStart>(WANT_START),
+        Router::typed<PlayerShot, &RtypeServer::handleShoot>(),
+    });
+    return ROUTES;
+}
+
+// Who may send a code: players only, players and spectators, or anyone
+// (the handshakes, charged to the per-source budget)
+enum IngressScope : uint8_t { SCOPE_PLAYER, SCOPE_VIEWER, SCOPE_OPEN };
+
+struct IngressRule {
+    size_t min_size;
+    size_t max_size;
+    IngressClass cls;
+    IngressScope scope;
+};
+
+// Payload sizes as sent by RtypeClient, code byte excluded
+static const std::unordered_map<uint8_t, IngressRule> INGRESS_RULES = {
+    {CONNECTION_REQUEST, {message::size<ConnectionRequest>(),
+        message::size<ConnectionRequest>(), INGRESS_CONTROL, SCOPE_OPEN}},
+    {DISCONNECTION, {0, 0, INGRESS_CONTROL, SCOPE_VIEWER}},
+    {SPECTATE, {message::size<Spectate>(), message::size<Spectate>(),
+        INGRESS_CONTROL, SCOPE_OPEN}},
+    {PING, {LINK_PING_SIZE, LINK_PING_SIZE, INGRESS_LINK, SCOPE_VIEWER}},
+    {PONG, {LINK_PING_SIZE, LINK_PING_SIZE, INGRESS_LINK, SCOPE_VIEWER}},
+    {ACK, {message::size<Ack>(), message::size<Ack>(), INGRESS_LINK,
+        SCOPE_PLAYER}},
+    {RESYNC_REQUEST, {0, 0, INGRESS_CONTROL, SCOPE_PLAYER}},
+    {WANT_START, {0, 0, INGRESS_CONTROL, SCOPE_PLAYER}},
+    {CLIENT_EVENT, {sizeof(te::event::Events), sizeof(te::event::Events),
+        INGRESS_EVENT, SCOPE_PLAYER}},
+    {PLAYER_SHOT, {message::size<PlayerShot>(), message::size<PlayerShot>(),
+        INGRESS_SHOT, SCOPE_PLAYER}},
+};
+
+bool RtypeServer::admit(uint8_t code, const std::vector<uint8_t>& data,
+    const net::Address& sender) {
+    auto rule = INGRESS_RULES.find(code);
+    if (rule == INGRESS_RULES.end())
+        return true;
+    if (data.size() < rule->second.min_size ||
+        data.size() > rule->second.max_size) {
+        _metrics.dropped_size++;
+        return false;
+    }
+
+    auto now = TokenBucket::Clock::now();
+    ClientSession* session = findSession(sender);
+    auto spectator = _spectators.end();
+    if (session == nullptr && rule->second.scope != SCOPE_PLAYER)
+        spectator = _spectators.find(addressToString(sender));
+    bool allowed;
+    if (session != nullptr) {
+        allowed = session->ingress.allow(rule->second.cls, now);
+    } else if (spectator != _spectators.end()) {
+        allowed = spectator->second.ingress.allow(rule->second.cls, now);
+    } else if (rule->second.scope == SCOPE_OPEN) {
+        allowed = _handshakes.allow(sender.getIP(), now);
+    } else {
+        _metrics.dropped_unknown++;
+        return false;
+    }
+    if (!allowed)
+        _metrics.dropped_limited++;
+    return allowed;
 }
 
 void RtypeServer::registerProtocolHandlers() {
-    _server.registerPacketHandler(CONNECTION_REQUEST,
-        [this](const std::vector<uint8_t>& data, const net::Address& sender) {
-            handleConnectionRequest(data, sender);
-        });
+    for (size_t code = 0; code < routes().size(); ++code) {
+        if (routes()[code] == nullptr)
+            continue;
+        _server.registerPacketHandler(static_cast<uint8_t>(code),
+            [this, code](const std::vector<uint8_t>& data,
+                const net::Address& sender) {
+                _metrics.onReceive(data.size() + 1);
+                if (admit(static_cast<uint8_t>(code), data, sender))
+                    routes()[code](*this, data, sender);
+            });
+    }
+}
 
-    _server.registerPacketHandler(DISCONNECTION,
-        [this](const std::vector<uint8_t>& data, const net::Address& sender) {
-            handleDisconnection(data, sender);
-        });
+void RtypeServer::queuePacket(const net::Address& client,
+    const std::vector<uint8_t>& packet) {
+    _server.queuePacket(client, packet);
+    _metrics.onSend(packet.size(), 1);
+}
 
-    _server.registerPacketHandler(PING,
-        [this](const std::vector<uint8_t>& data, const net::Address& sender) {
-            handlePing(data, sender);
-        });
+void RtypeServer::queueReliable(ClientSession& session,
+    const std::vector<uint8_t>& packet) {
+    // A reclaim resets the channel and sends a keyframe instead
+    if (session.parked)
+        return;
+    if (const auto* wrapped = session.reliable.wrap(packet))
+        queueToSession(session, *wrapped);
+}
 
-    _server.registerPacketHandler(PONG,
-        [this](const std::vector<uint8_t>& data, const net::Address& sender) {
-            handlePong(data, sender);
-        });
+void RtypeServer::queueReliableBroadcast(const std::vector<uint8_t>& packet) {
+    for (auto& [key, session] : _sessions)
+        queueReliable(session, packet);
+    queueSpectators(packet);
+}
 
-    _server.registerPacketHandler(CLIENT_EVENT,
-        [this](const std::vector<uint8_t>& data, const net::Address& sender) {
-            handleUserEvent(data, sender);
-        });
+void RtypeServer::resendReliable() {
+    std::vector<net::Address> stalled;
 
-    _server.registerPacketHandler(WANT_START,
-        [this](const std::vector<uint8_t>& data, const net::Address& sender) {
-            handleWantStart(data, sender);
-        });
-    _server.registerPacketHandler(PLAYER_SHOT,
-        [this](const std::vector<uint8_t>& data, const net::Address& sender) {
-            handleShoot(data, sender);
+    for (auto& [key, session] : _sessions) {
+        if (session.parked)
+            continue;
+        float timeout = std::max(_config.reliable_resend_time,
+            2.0f * session.link.rtt());
+        session.reliable.resends(timeout,
+            [this, &session](const std::vector<uint8_t>& packet) {
+                queueToSession(session, packet);
+            });
+        if (session.reliable.stalled() >= _config.reliable_stall_time)
+            stalled.push_back(session.address);
+    }
+    // Nothing gets through to them, treated like a lost connection
+    for (const auto& addr : stalled)
+        parkSession(addr);
+}
+
+void RtypeServer::queueSnapshot(SnapshotStream stream,
+    const std::vector<uint8_t>& raw) {
+    const std::vector<uint8_t>& packet = compress(raw);
+
+    for (auto& [key, session] : _sessions) {
+        if (session.rate.due(stream))
+            queueToSession(session, packet);
+    }
+    queueSpectators(packet);
+}
+
+const std::vector<uint8_t>& RtypeServer::compress(
+    const std::vector<uint8_t>& packet) {
+    if (_config.compression_threshold == 0 || packet.empty() ||
+        packet.size() < _config.compression_threshold)
+        return packet;
+
+    auto begin = std::chrono::steady_clock::now();
+    bool compressed = _codec.compress(packet, _compressed);
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+    _metrics.onCompress(packet[0], packet.size(),
+        compressed ? _compressed.size() : packet.size(), micros);
+    return compressed ? _compressed : packet;
+}
+
+void RtypeServer::queueToSession(ClientSession& session,
+    const std::vector<uint8_t>& packet) {
+    if (session.parked)
+        return;
+    if (session.outbox.add(packet))
+        return;
+    flushSession(session);
+    if (!session.outbox.add(packet))
+        queuePacket(session.address, packet);
+}
+
+void RtypeServer::flushSession(ClientSession& session) {
+    if (session.outbox.empty())
+        return;
+    _server.queuePacket(session.address, session.outbox.data());
+    _metrics.onSend(session.outbox.size(), 1, session.outbox.count());
+    session.outbox.clear();
+}
+
+void RtypeServer::queueSpectators(const std::vector<uint8_t>& packet) {
+    if (_spectators.empty())
+        return;
+    if (_spectatorOutbox.add(packet))
+        return;
+    flushSpectators();
+    if (_spectatorOutbox.add(packet))
+        return;
+    for (const auto& [key, spectator] : _spectators)
+        _server.queuePacket(spectator.address, packet);
+    _metrics.onSend(packet.size(), _spectators.size());
+}
+
+void RtypeServer::flushSpectators() {
+    if (_spectatorOutbox.empty())
+        return;
+    // Same encoded datagram for every spectator
+    const std::vector<uint8_t>& datagram = _spectatorOutbox.data();
+    for (const auto& [key, spectator] : _spectators)
+        _server.queuePacket(spectator.address, datagram);
+    _metrics.onSend(_spectatorOutbox.size(), _spectators.size(),
+        _spectatorOutbox.count());
+    _spectatorOutbox.clear();
+}
+
+void RtypeServer::sendSpectatorKeyframe() {
+    _packet.clear();
+    _packet.push_back(KEYFRAME);
+    encodeKeyframe(_packet, _wavesSpawned);
+    queueSpectators(compress(_packet));
+}
+
+void RtypeServer::flushOutbox() {
+    for (auto& [key, session] : _sessions)
+        flushSession(session);
+    flushSpectators();
+}
+
+ClientSession* RtypeServer::findSession(const net::Address& addr) {
+    auto it = _sessions.find(addressToString(addr));
+    if (it == _sessions.end())
+        return nullptr;
+    return &it->second;
+}
+
+ClientSession* RtypeServer::reclaimSession(uint64_t token,
+    const net::Address& addr) {
+    auto it = std::find_if(_sessions.begin(), _sessions.end(),
+        [token](const auto& entry) { return entry.second.token == token; });
+    if (it == _sessions.end())
+        return nullptr;
+
+    auto node = _sessions.extract(it);
+    node.key() = addressToString(addr);
+    node.mapped().address = addr;
+    node.mapped().parked = false;
+    node.mapped().link.reset();
+    return &_sessions.insert(std::move(node)).position->second;
+}
+
+void RtypeServer::parkSession(const net::Address& addr) {
+    ClientSession* session = findSession(addr);
+    if (session == nullptr || session->parked)
+        return;
+    LOG_INFO("Server", "Parking session", {{"entity", session->entity},
+        {"grace_s", _config.session_grace_time}});
+    session->parked = true;
+    session->parked_at = std::chrono::steady_clock::now();
+    session->outbox.clear();
+}
+
+void RtypeServer::expireSessions() {
+    auto now = std::chrono::steady_clock::now();
+    auto grace = std::chrono::duration<float>(_config.session_grace_time);
+    std::vector<net::Address> expired;
+
+    for (const auto& [key, session] : _sessions) {
+        if (session.parked && now - session.parked_at >= grace)
+            expired.push_back(session.address);
+    }
+    for (const auto& addr : expired)
+        removeSession(addr);
+}
+
+void RtypeServer::removeSession(const net::Address& addr) {
+    auto it = _sessions.find(addressToString(addr));
+    if (it == _sessions.end())
+        return;
+
+    size_t entity_id = it->second.entity;
+    LOG_INFO("Server", "Removing session",
+        {{"session", it->first}, {"entity", entity_id}});
+
+    auto player_it = std::find_if(_players.begin(), _players.end(),
+        [entity_id](const std::pair<size_t, PLAYER_STATE>& p) {
+            return p.first == entity_id;
         });
+    if (player_it != _players.end())
+        _players.erase(player_it);
+    unsetBaseline(entity_id);
+    removeEntity(entity_id);
+    // Freed for the next player, whatever input it left is dropped
+    size_t slot = entity_id - EntityField::PLAYER_BEGIN;
+    if (slot < _playerSlots.size()) {
+        _playerSlots[slot] = false;
+        _entity_events[slot].reset();
+    }
+    _sessions.erase(it);
+    startCountdownIfReady();
 }
 
-void RtypeServer::sendErrorTooManyClients(const net::Address& client) {
-    std::vector<uint8_t> packet;
+void RtypeServer::dumpMetrics() {
+    LOG_INFO("Metrics", "network", {{"ticks", _metrics.ticks},
+        {"syscalls_per_tick", _metrics.syscallsPerTick()},
+        {"datagrams_out", _metrics.datagrams_out},
+        {"bytes_out", _metrics.bytes_out},
+        {"messages_out", _metrics.messages_out},
+        {"datagrams_in", _metrics.datagrams_in},
+        {"bytes_in", _metrics.bytes_in},
+        {"dropped_size", _metrics.dropped_size},
+        {"dropped_unknown", _metrics.dropped_unknown},
+        {"dropped_limited", _metrics.dropped_limited},
+        {"challenges", _metrics.challenges},
+        {"ennemies_down", _metrics.ennemies_down},
+        {"projectiles_down", _metrics.projectiles_down},
+        {"ennemies_alive", _liveEnnemies.size()},
+        {"projectiles_alive", _liveProjectiles.size()},
+        {"spectators", _spectators.size()}});
+    for (const auto& [code, stats] : _metrics.compression) {
+        LOG_INFO("Metrics", "compression", {{"code", static_cast<int>(code)},
+            {"packets", stats.packets}, {"bytes_in", stats.bytes_in},
+            {"bytes_out", stats.bytes_out},
+            {"ratio", stats.bytes_in == 0 ? 1.0
+                : static_cast<double>(stats.bytes_out) / stats.bytes_in},
+            {"us_per_packet", stats.micros / stats.packets}});
+    }
+    for (const auto& [key, session] : _sessions) {
+        LOG_INFO("Metrics", "link", {{"session", key},
+            {"entity", session.entity}, {"rtt_ms", session.link.rtt()},
+            {"jitter_ms", session.link.jitter()},
+            {"loss", session.link.loss()},
+            {"rate_divider", session.rate.divider()}});
+    }
+    _metrics.reset();
+}
 
-    packet.push_back(ERROR_TOO_MANY_CLIENTS);
-    _server.queuePacket(client, packet);
+const LinkStats* RtypeServer::getLinkStats(size_t entity) const {
+    for (const auto& [key, session] : _sessions) {
+        if (session.entity == entity)
+            return &session.link;
+    }
+    return nullptr;
 }
 
-void RtypeServer::sendConnectionAccepted(const net::Address& client,
-    size_t entity_id) {
-    std::vector<uint8_t> packet;
+void RtypeServer::sendErrorTooManyClients(const net::Address& client) {
+    _packet.clear();
+    _packet.push_back(ERROR_TOO_MANY_CLIENTS);
+    queuePacket(client, _packet);
+}
 
-    packet.push_back(CONNECTION_ACCEPTED);
-    append(packet, entity_id);
-    _server.queuePacket(client, packet);
+void RtypeServer::sendConnectionAccepted(ClientSession& session) {
+    message::encode(ConnectionAccepted{session.entity, session.token},
+        _packet);
+    queueReliable(session, _packet);
 }
 
-void RtypeServer::sendPong(const net::Address& client) {
-    std::vector<uint8_t> packet;
+void RtypeServer::sendPings() {
+    for (auto& [key, session] : _sessions) {
+        if (session.parked)
+            continue;
+        session.link.checkTimeouts();
+        if (session.link.samples() > 0)
+            session.rate.onLinkSample(session.link.rtt(),
+                session.link.loss());
+        session.link.makePing(_packet);
+        queueToSession(session, _packet);
+    }
+}
 
-    packet.push_back(PONG);
-    _server.queuePacket(client, packet);
+void RtypeServer::sendPong(const net::Address& client,
+    const std::vector<uint8_t>& ping) {
+    LinkStats::makePong(ping, _packet);
+    queuePacket(client, _packet);
 }
 
 void RtypeServer::sendDisconnection(const net::Address& client) {
-    std::vector<uint8_t> packet;
-
-    packet.push_back(DISCONNECTION);
-    _server.queuePacket(client, packet);
+    _packet.clear();
+    _packet.push_back(DISCONNECTION);
+    queuePacket(client, _packet);
 }
 
-void RtypeServer::handleConnectionRequest(const std::vector<uint8_t>& data,
+void RtypeServer::handleConnectionRequest(const ConnectionRequest& msg,
     const net::Address& sender) {
-    if (_server.getClientCount() > _max_clients) {
-        std::cout << "[Server] Too many clients! Rejecting "
-                  << sender.getIP() << ":" << sender.getPort() << std::endl;
+    if (!checkCookie(msg.cookie, sender))
+        return;
+
+    _spectators.erase(addressToString(sender));
+    ClientSession* session = findSession(sender);
+    // Token 0 is only sent before the first CONNECTION_ACCEPTED, so from
+    // a known address it is a duplicate of that request, like our token
+    if (session != nullptr &&
+        (msg.token == 0 || msg.token == session->token)) {
+        LOG_DEBUG("Server", "Duplicate CONNECTION_REQUEST",
+            {{"addr", addressToString(sender)},
+            {"entity", session->entity}});
+        sendConnectionAccepted(*session);
+        return;
+    }
+    if (session == nullptr && msg.token != 0)
+        session = reclaimSession(msg.token, sender);
+    if (session != nullptr) {
+        LOG_INFO("Server", "Client reconnected, keeping its session",
+            {{"addr", addressToString(sender)},
+            {"entity", session->entity}});
+        // A reclaim restarts the peer's reliable channel
+        session->reliable.reset();
+        sendConnectionAccepted(*session);
+        sendKeyframe(*session);
+        return;
+    }
+
+    // Spectators have their own limit, parked sessions keep their slot
+    if (_sessions.size() >= _max_clients) {
+        LOG_WARN("Server", "Too many clients, rejecting",
+            {{"addr", addressToString(sender)}});
+        sendErrorTooManyClients(sender);
+        return;
+    }
+
+    auto spawned = spawnPlayerEntity(sender);
+    if (!spawned.has_value()) {
+        LOG_WARN("Server", "No free player slot, rejecting",
+            {{"addr", addressToString(sender)}});
         sendErrorTooManyClients(sender);
         return;
     }
+    size_t entity_id = spawned.value();
+    LOG_INFO("Server", "Client connected",
+        {{"addr", addressToString(sender)},
+        {"clients", _server.getClientCount()}, {"max", _max_clients},
+        {"entity", entity_id}});
 
-    size_t entity_id = spawnPlayerEntity(sender);
-    std::cout << "[Server] Client connected: " << sender.getIP() << ":"
-        << sender.getPort() << " (" << (_server.getClientCount())
-        << "/" << _max_clients << ") - Entity ID: " << entity_id << std::endl;
+    sendConnectionAccepted(*findSession(sender));
+}
+
+bool RtypeServer::checkCookie(uint64_t cookie, const net::Address& sender) {
+    if (cookie != 0 && _cookies.check(cookie, addressToString(sender),
+        CookieJar::Clock::now()))
+        return true;
+    sendChallenge(sender);
+    return false;
+}
+
+void RtypeServer::sendChallenge(const net::Address& client) {
+    uint64_t cookie = _cookies.issue(addressToString(client),
+        CookieJar::Clock::now());
 
-    sendConnectionAccepted(sender, entity_id);
+    message::encode(ConnectionChallenge{cookie}, _packet);
+    queuePacket(client, _packet);
+    _metrics.challenges++;
 }
 
 void RtypeServer::handleDisconnection(const std::vector<uint8_t>& data,
                                        const net::Address& sender) {
-    std::cout << "[Server] Client disconnected: " << sender.getIP()
-              << ":" << sender.getPort() << std::endl;
-
-    std::string addr_key = addressToString(sender);
-    auto it = _client_entities.find(addr_key);
-    if (it != _client_entities.end()) {
-        size_t entity_id = it->second;
-        std::cout << "[Server] Removing entity " << entity_id << "\n";
-
-        auto player_it = std::find_if(_players.begin(), _players.end(),
-            [entity_id](const std::pair<size_t, PLAYER_STATE>& p) {
-                return p.first == entity_id;
-            });
-        if (player_it != _players.end()) {
-            std::cout << "[Server] Removing player "
-                << entity_id << " from players list\n";
-            _players.erase(player_it);
-        }
-        removeEntity(entity_id);
-        _client_entities.erase(it);
+    LOG_INFO("Server", "Client disconnected",
+        {{"addr", addressToString(sender)}});
+    if (_spectators.erase(addressToString(sender)) == 0)
+        removeSession(sender);
+}
+
+void RtypeServer::handleSpectate(const Spectate& msg,
+    const net::Address& sender) {
+    if (!checkCookie(msg.cookie, sender))
+        return;
+    if (_spectators.size() >= _config.max_spectators) {
+        LOG_WARN("Server", "Too many spectators, rejecting",
+            {{"addr", addressToString(sender)}});
+        sendErrorTooManyClients(sender);
+        return;
     }
+    _spectators.insert_or_assign(addressToString(sender),
+        Spectator(sender, _config));
+    LOG_INFO("Server", "Spectator joined",
+        {{"addr", addressToString(sender)},
+        {"spectators", _spectators.size()}});
+
+    _packet.clear();
+    _packet.push_back(KEYFRAME);
+    encodeKeyframe(_packet, _wavesSpawned);
+    queuePacket(sender, compress(_packet));
+}
+
+void RtypeServer::handleResyncRequest(const std::vector<uint8_t>& data,
+    const net::Address& sender) {
+    ClientSession* session = findSession(sender);
+    if (session == nullptr)
+        return;
+    LOG_DEBUG("Server", "Resync requested", {{"entity", session->entity}});
+    sendKeyframe(*session);
 }
 
 void RtypeServer::handlePing(const std::vector<uint8_t>& data,
     const net::Address& sender) {
-    std::cout << "[Server] Ping from " << sender.getIP() << ":"
-              << sender.getPort() << " - sending pong" << "\n";
-    sendPong(sender);
+    sendPong(sender, data);
 }
 
 void RtypeServer::handlePong(const std::vector<uint8_t>& data,
     const net::Address& sender) {
-    std::cout << "[Server] Pong from " << sender.getIP() << ":"
-              << sender.getPort() << "\n";
+    ClientSession* session = findSession(sender);
+    if (session != nullptr)
+        session->link.onPong(data);
+}
+
+void RtypeServer::handleAck(const Ack& msg, const net::Address& sender) {
+    ClientSession* session = findSession(sender);
+    if (session == nullptr)
+        return;
+    session->reliable.onAck(msg);
+    session->reliable.release(
+        [this, session](const std::vector<uint8_t>& packet) {
+            queueToSession(*session, packet);
+        });
 }
 
 void RtypeServer::handleUserEvent(const std::vector<uint8_t>& data,
     const net::Address& sender) {
     te::event::Events events;
     if (!net::PacketSerializer::deserialize(data, events)) {
-        std::cerr << "[Server] Failed to deserialize events (size: "
-            << data.size() << ", expected: "
-            << sizeof(te::event::Events) << ")" << "\n";
+        LOG_WARN("Server", "Failed to deserialize events",
+            {{"size", data.size()},
+            {"expected", sizeof(te::event::Events)}});
         return;
     }
 
-    std::string addr_key = addressToString(sender);
-    auto it = _client_entities.find(addr_key);
-    if (it == _client_entities.end()) {
-        std::cerr << "[Server] Received event from unknown client: "
-                  << sender.getIP() << ":" << sender.getPort() << "\n";
+    ClientSession* session = findSession(sender);
+    if (session == nullptr)
         return;
-    }
-
-    size_t entity_id = it->second;
-    _entity_events[entity_id] = events;
-}
 
-void RtypeServer::processEntitiesEvents() {
-    for (auto& [entity_id, events] : _entity_events) {
-        setEvents(events);
-        emit(entity_id);
-    }
-    _entity_events.clear();
+    size_t slot = session->entity - EntityField::PLAYER_BEGIN;
+    if (slot < _entity_events.size())
+        _entity_events[slot] = events;
 }
 
-void RtypeServer::append(std::vector<uint8_t>& vec, uint32_t value) const {
-    std::array<uint8_t, sizeof(uint32_t)> bytes;
-    std::memcpy(bytes.data(), &value, sizeof(uint32_t));
-    vec.insert(vec.end(), bytes.begin(), bytes.end());
-}
+void RtypeServer::trackLifecycle() {
+    _ennemyWave.assign(EntityField::ENEMIES_END - EntityField::ENEMIES_BEGIN,
+        0);
+    _waveAlive.assign(NB_WAVES, 0);
 
-void RtypeServer::append(std::vector<uint8_t>& vec, size_t value) const {
-    std::array<uint8_t, sizeof(size_t)> bytes;
-    std::memcpy(bytes.data(), &value, sizeof(size_t));
-    vec.insert(vec.end(), bytes.begin(), bytes.end());
-}
+    _liveEnnemies.onSpawn([this](size_t e) {
+        _waveAlive[_ennemyWave[e - EntityField::ENEMIES_BEGIN]]++;
+    });
+    _liveEnnemies.onDeath([this](size_t e) {
+        size_t wave = _ennemyWave[e - EntityField::ENEMIES_BEGIN];
 
+        _metrics.ennemies_down++;
+        if (_waveAlive[wave] > 0 && --_waveAlive[wave] == 0)
+            LOG_INFO("Server", "Wave cleared", {{"wave", wave},
+                {"ennemies_left", _liveEnnemies.size()}});
+    });
+    _liveProjectiles.onDeath([this](size_t e) {
+        size_t slot = e - EntityField::PROJECTILES_BEGIN;
 
-void RtypeServer::append(std::vector<uint8_t>& vec, int64_t value) const {
-    std::array<uint8_t, sizeof(int64_t)> bytes;
-    std::memcpy(bytes.data(), &value, sizeof(int64_t));
-    vec.insert(vec.end(), bytes.begin(), bytes.end());
+        _metrics.projectiles_down++;
+        _timers.cancel(_projectileTimeouts[slot]);
+        _projectileTimeouts[slot] = 0;
+    });
 }
 
-void RtypeServer::append(std::vector<uint8_t>& vec, float value) const {
-    std::array<uint8_t, sizeof(float)> bytes;
-    std::memcpy(bytes.data(), &value, sizeof(float));
-    vec.insert(vec.end(), bytes.begin(), bytes.end());
+void RtypeServer::processEntitiesEvents() {
+    for (size_t slot = 0; slot < _entity_events.size(); ++slot) {
+        if (!_entity_events[slot].has_value())
+            continue;
+        setEvents(_entity_events[slot].value());
+        emit(EntityField::PLAYER_BEGIN + slot);
+        _entity_events[slot].reset();
+    }
 }
 
 std::string RtypeServer::addressToString(const net::Address& addr) const {
@@ -441,18 +929,37 @@ std::string RtypeServer::addressToString(const net::Address& addr) const {
 }
 
 void RtypeServer::spawnEnnemyEntity(size_t waveNb) {
+    auto& healths = getComponent<addon::eSpec::Health>();
+    size_t first = _nextEnnemyE;
+
     _nextEnnemyE = createMobWave(waveNb,
         _nextEnnemyE, EntityField::ENEMIES_END);
+    for (size_t e = first; e < _nextEnnemyE; ++e) {
+        _ennemyWave[e - EntityField::ENEMIES_BEGIN] = waveNb;
+        if (e < healths.size() && healths[e].has_value())
+            _liveEnnemies.add(e, healths[e].value().amount);
+        else
+            _liveEnnemies.add(e);
+    }
+    _wavesSpawned = waveNb + 1;
     sendEnnemySpawn(waveNb);
 }
 
-size_t RtypeServer::spawnPlayerEntity(const net::Address& client) {
-    size_t entity = _nextPlayerE++;
+std::optional<size_t> RtypeServer::spawnPlayerEntity(
+    const net::Address& client) {
+    auto slot = std::find(_playerSlots.begin(), _playerSlots.end(), false);
+    if (slot == _playerSlots.end())
+        return std::nullopt;
+    *slot = true;
+    size_t entity = EntityField::PLAYER_BEGIN + (slot - _playerSlots.begin());
 
     createEntity(entity, "player");
+    setBaseline(entity, "player");
 
     std::string addr_key = addressToString(client);
-    _client_entities[addr_key] = entity;
+    _sessions.insert_or_assign(addr_key,
+        ClientSession(client, entity, std::max<uint64_t>(_tokenRng(), 1),
+            _config));
     _players.push_back({entity, WAIT_GAME});
     return entity;
 }
@@ -461,126 +968,79 @@ void RtypeServer::sendEnnemySpawn(size_t waveNb) {
     if (_server.getClientCount() == 0)
         return;
 
-    std::vector<uint8_t> packet;
-
-    packet.push_back(NEW_WAVE);
-
-    append(packet, waveNb);
-
-    std::cout << "[Server] Sending spawn wave : WAVE " << waveNb << "\n";
-    _server.queueBroadcast(packet);
+    LOG_INFO("Server", "Sending spawn wave", {{"wave", waveNb}});
+    message::encode(NewWave{static_cast<uint32_t>(waveNb)}, _packet);
+    queueReliableBroadcast(_packet);
 }
 
 void RtypeServer::sendEnnemiesData() {
     if (_server.getClientCount() == 0)
         return;
 
-    std::vector<uint8_t> packet;
-    packet.push_back(ProtocolCode::ENNEMIES_DATA);
-
-    auto& positions = getComponent<addon::physic::Position2>();
-    auto& velocities = getComponent<addon::physic::Velocity2>();
-
-    for (auto &&[entity, pos, vel] :
-        ECS::IndexedZipper(positions, velocities)) {
-        if (entity < EntityField::ENEMIES_BEGIN ||
-            entity >= EntityField::ENEMIES_END)
-            continue;
-
-        append(packet, entity);
-        append(packet, pos.x);
-        append(packet, pos.y);
-        append(packet, vel.x);
-        append(packet, vel.y);
-    }
-    _server.queueBroadcast(packet);
+    _packet.clear();
+    _packet.push_back(ProtocolCode::ENNEMIES_DATA);
+    encodeEnnemiesData(_packet);
+    queueSnapshot(STREAM_ENNEMIES, _packet);
 }
 
 void RtypeServer::sendProjectilesData() {
     if (_server.getClientCount() == 0)
         return;
 
-    std::vector<uint8_t> packet;
-    packet.push_back(ProtocolCode::PROJECTILES_DATA);
-
-    auto& positions = getComponent<addon::physic::Position2>();
-    auto& velocities = getComponent<addon::physic::Velocity2>();
-    auto& damages = getComponent<addon::eSpec::Damage>();
-
-    for (auto &&[entity, pos, vel, dmg] :
-        ECS::IndexedZipper(positions, velocities, damages)) {
-        if (entity < EntityField::PROJECTILES_BEGIN ||
-            entity >= EntityField::PROJECTILES_END)
-            continue;
-
-        append(packet, entity);
-        append(packet, pos.x);
-        append(packet, pos.y);
-        append(packet, vel.x);
-        append(packet, vel.y);
-        if (dmg.amount == 10) {
-            append(packet, static_cast<size_t>(Weapons::ROCKET));
-        } else if (dmg.amount == 3) {
-            append(packet, static_cast<size_t>(Weapons::SHOTGUN));
-        } else {
-            append(packet, static_cast<size_t>(Weapons::MINIGUN));
-        }
-    }
-    _server.queueBroadcast(packet);
+    _packet.clear();
+    _packet.push_back(ProtocolCode::PROJECTILES_DATA);
+    encodeProjectilesData(_packet);
+    queueSnapshot(STREAM_PROJECTILES, _packet);
 }
 
 void RtypeServer::sendPlayersData() {
     if (_server.getClientCount() == 0)
         return;
 
-    std::vector<uint8_t> packet;
-    packet.push_back(ProtocolCode::PLAYERS_DATA);
-
-    auto& positions = getComponent<addon::physic::Position2>();
-    auto& velocities = getComponent<addon::physic::Velocity2>();
-    auto& healths = getComponent<addon::eSpec::Health>();
+    _packet.clear();
+    _packet.push_back(ProtocolCode::PLAYERS_DATA);
+    encodePlayersData(_packet);
+    queueSnapshot(STREAM_PLAYERS, _packet);
+}
 
-    for (auto &&[entity, pos, vel, hp] :
-        ECS::IndexedZipper(positions, velocities, healths)) {
-        if (entity < EntityField::PLAYER_BEGIN ||
-            entity > EntityField::PLAYER_END)
-            continue;
+void RtypeServer::sendCountdown(uint32_t delay_ms) {
+    LOG_INFO("Server", "Broadcasting GAME_COUNTDOWN_START",
+        {{"ms", delay_ms}});
+    message::encode(CountdownStart{delay_ms}, _packet);
+    queueReliableBroadcast(_packet);
+}
 
-        append(packet, entity);
-        append(packet, pos.x);
-        append(packet, pos.y);
-        append(packet, vel.x);
-        append(packet, vel.y);
-        append(packet, hp.amount);
-    }
-    _server.queueBroadcast(packet);
+void RtypeServer::sendKeyframe(ClientSession& session) {
+    _packet.clear();
+    _packet.push_back(KEYFRAME);
+    encodeKeyframe(_packet, _wavesSpawned);
+    LOG_DEBUG("Server", "Sending keyframe", {{"entity", session.entity},
+        {"bytes", _packet.size()}});
+    queueReliable(session, compress(_packet));
 }
 
 void RtypeServer::sendGameStart() {
-    std::vector<uint8_t> packet;
-    packet.push_back(GAME_START);
+    _packet.clear();
+    _packet.push_back(GAME_START);
 
-    std::cout << "[Server] Broadcasting GAME_START to all clients\n";
-    _server.queueBroadcast(packet);
+    LOG_INFO("Server", "Broadcasting GAME_START");
+    queueReliableBroadcast(_packet);
 }
 
 void RtypeServer::handleWantStart(const std::vector<uint8_t>& data,
     const net::Address& sender) {
-    if (getGameState() != GAME_WAITING) {
-        std::cout << "[Server] Ignoring WANT_START from " << sender.getIP()
-                  << ":" << sender.getPort() << " - game already started\n";
+    // Players may ready up from the results screen for the next match
+    if (getGameState() != GAME_WAITING && getGameState() != GAME_ENDED) {
+        LOG_DEBUG("Server", "Ignoring WANT_START, game already started",
+            {{"addr", addressToString(sender)}});
         return;
     }
 
-    std::string addr_key = addressToString(sender);
-    auto it = _client_entities.find(addr_key);
-    if (it == _client_entities.end()) {
-        std::cerr << "[Server] Received WANT_START from unknown client: "
-                  << sender.getIP() << ":" << sender.getPort() << "\n";
+    ClientSession* session = findSession(sender);
+    if (session == nullptr)
         return;
-    }
 
-    size_t entity_id = it->second;
+    size_t entity_id = session->entity;
 
     auto player_it = std::find_if(_players.begin(), _players.end(),
         [entity_id](const std::pair<size_t, PLAYER_STATE>& p) {
@@ -588,92 +1048,125 @@ void RtypeServer::handleWantStart(const std::vector<uint8_t>& data,
         });
 
     if (player_it != _players.end()) {
-        if (player_it->second == WAIT_GAME) {
+        if (player_it->second != READY_TO_START) {
             player_it->second = READY_TO_START;
-            std::cout << "[Server] Player " << entity_id
-                << " is ready to start ("
-                << sender.getIP() << ":" << sender.getPort() << ")\n";
-
-            bool all_ready = std::all_of(_players.begin(), _players.end(),
-                [](const std::pair<size_t, PLAYER_STATE>& p) {
-                    return p.second == READY_TO_START;
-                });
+            LOG_INFO("Server", "Player ready", {{"entity", entity_id},
+                {"addr", addressToString(sender)}});
+            startCountdownIfReady();
+        } else {
+            LOG_DEBUG("Server", "Player already ready",
+                {{"entity", entity_id}});
+        }
+    }
+}
 
-            if (all_ready && !_players.empty()) {
-                std::cout << "[Server] All " << _players.size()
-                          << " players are ready! Starting game...\n";
+void RtypeServer::startCountdownIfReady() {
+    if (getGameState() != GAME_WAITING)
+        return;
 
-                for (auto& player : _players) {
-                    player.second = PLAYER_ALIVE;
-                }
+    bool all_ready = std::all_of(_players.begin(), _players.end(),
+        [](const std::pair<size_t, PLAYER_STATE>& p) {
+            return p.second == READY_TO_START;
+        });
 
-                setGameState(IN_GAME);
-                sendGameStart();
-            } else {
-                size_t ready_count = std::count_if(_players.begin(),
-                    _players.end(),
-                    [](const std::pair<size_t, PLAYER_STATE>& p) {
-                        return p.second == READY_TO_START;
-                    });
-                std::cout << "[Server] Waiting for players... (" << ready_count
-                          << "/" << _players.size() << " ready)\n";
-            }
-        } else {
-            std::cout << "[Server] Player " << entity_id
-                      << " already marked as ready or in different state\n";
-        }
+    if (all_ready && !_players.empty()) {
+        LOG_INFO("Server", "All players ready, starting countdown",
+            {{"players", _players.size()},
+            {"seconds", _config.countdown_time}});
+        setGameState(GAME_COUNTDOWN);
+    } else {
+        size_t ready_count = std::count_if(_players.begin(),
+            _players.end(),
+            [](const std::pair<size_t, PLAYER_STATE>& p) {
+                return p.second == READY_TO_START;
+            });
+        LOG_INFO("Server", "Waiting for players",
+            {{"ready", ready_count}, {"players", _players.size()}});
     }
 }
 
-void RtypeServer::handleShoot(const std::vector<uint8_t>& data,
+void RtypeServer::handleShoot(const PlayerShot& msg,
     const net::Address& sender) {
-    Weapons weapon = static_cast<Weapons>(data[0]);
+    if (msg.weapon >= Weapons::ENDWEAPON)
+        return;
+    Weapons weapon = static_cast<Weapons>(msg.weapon);
+    uint16_t shot = msg.shot;
 
-    std::string addr_key = addressToString(sender);
-    auto it = _client_entities.find(addr_key);
-    if (it == _client_entities.end())
+    ClientSession* session = findSession(sender);
+    if (session == nullptr)
         return;
 
     const auto &player = getComponent<addon::intact::Player>();
     const auto &position = getComponent<addon::physic::Position2>();
-    auto &velocities = getComponent<addon::physic::Velocity2>();
-
-    if (_nextProjectileE > EntityField::PROJECTILES_END)
-        _nextProjectileE = EntityField::PROJECTILES_BEGIN;
-    for (ECS::Entity e = 0; e < player.size() && e < position.size(); ++e) {
-        if (e == it->second && player[e].has_value() &&
-            position[e].has_value()) {
-            if (weapon == Weapons::ROCKET) {
-                createEntity(_nextProjectileE++, "rocket",
-                    {position[e].value().x + 60, position[e].value().y + 10});
-            } else if (weapon == Weapons::MINIGUN) {
-                createEntity(_nextProjectileE, "minigun",
-                    {position[e].value().x + 60,
-                    position[e].value().y + 25});
-                if (velocities[_nextProjectileE].has_value())
-                    velocities[_nextProjectileE++].value().y +=
-                        static_cast<float>((rand() % 120) - 60);
-            } else {
-                for (int i = 0; i < 10; i++) {
-                    if (_nextEnnemyE > EntityField::PROJECTILES_END)
-                        _nextEnnemyE = EntityField::PROJECTILES_BEGIN;
-                    createEntity(_nextProjectileE, "shotgun",
-                        {position[e].value().x + 60,
-                        position[e].value().y + 10});
-                    velocities[_nextProjectileE].value().y +=
-                        static_cast<float>((rand() % 200) - 100);
-                    velocities[_nextProjectileE++].value().x +=
-                        static_cast<float>((rand() % 80) - 40);
-                }
-            }
-        }
+    size_t e = session->entity;
+    if (e >= player.size() || e >= position.size() ||
+        !player[e].has_value() || !position[e].has_value())
+        return;
+
+    mat::Vector2f origin = {position[e].value().x, position[e].value().y};
+    auto projectiles = createShot(weapon, e, shot, origin, _nextProjectileE);
+    for (ECS::Entity p : projectiles) {
+        _liveProjectiles.add(p);
+        if (weapon == SHOTGUN)
+            scheduleTimeout(p, SHOTGUN_TIMEOUT);
     }
+    sendShotConfirmed({e, shot, static_cast<uint8_t>(weapon),
+        projectiles.front(), origin.x, origin.y});
 }
 
-void RtypeServer::checkGameOverConditions(bool lastWaveSpawned) {
-    static bool gameEndSent = false;
-    static te::Timestamp gameEndTimer(2.0f);  // 2 seconds delay
+void RtypeServer::sendShotConfirmed(const ShotSnapshot& shot) {
+    _packet.clear();
+    _packet.push_back(ProtocolCode::SHOT_CONFIRMED);
+    snapshot::write(_packet, shot);
+    // The only spawn event of these projectiles, it must not be lost
+    queueReliableBroadcast(_packet);
+}
+
+void RtypeServer::sendRemoved(LiveSet& live, ProtocolCode code) {
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto dead = live.sweep([&positions](size_t e) {
+        return e < positions.size() && positions[e].has_value();
+    }, _frame);
+    if (dead.empty())
+        return;
+
+    _packet.clear();
+    _packet.push_back(code);
+    for (size_t e : dead)
+        snapshot::write(_packet, e);
+    for (auto& [key, session] : _sessions)
+        queueToSession(session, _packet);
+    queueSpectators(_packet);
+}
 
+void RtypeServer::sendEnnemiesUpdate() {
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto& velocities = getComponent<addon::physic::Velocity2>();
+    auto& healths = getComponent<addon::eSpec::Health>();
+    auto hit = _liveEnnemies.changed([&healths](size_t e) -> int64_t {
+        if (e >= healths.size() || !healths[e].has_value())
+            return 0;
+        return healths[e].value().amount;
+    }, _frame);
+
+    _packet.clear();
+    _packet.push_back(ProtocolCode::ENNEMIES_UPDATE);
+    for (size_t e : hit) {
+        if (e >= positions.size() || e >= velocities.size() ||
+            !positions[e].has_value() || !velocities[e].has_value())
+            continue;
+        snapshot::write(_packet, EnnemySnapshot{e, positions[e].value().x,
+            positions[e].value().y, velocities[e].value().x,
+            velocities[e].value().y});
+    }
+    if (_packet.size() == 1)
+        return;
+    for (auto& [key, session] : _sessions)
+        queueToSession(session, _packet);
+    queueSpectators(_packet);
+}
+
+void RtypeServer::checkGameOverConditions(bool lastWaveSpawned) {
     auto& healths = getComponent<addon::eSpec::Health>();
     int alivePlayers = 0;
 
@@ -687,58 +1180,32 @@ void RtypeServer::checkGameOverConditions(bool lastWaveSpawned) {
             } else {
                 if (state == PLAYER_ALIVE) {
                     state = PLAYER_DEAD;
-                    std::cout << "[Server] Player " << entity_id
-                              << " died!\n";
+                    LOG_INFO("Server", "Player died",
+                        {{"entity", entity_id}});
                 }
             }
         }
     }
 
-    if (!gameEndSent && alivePlayers == 0) {
-        std::cout << "[Server] All players are dead! Game Over - DEFEAT!\n";
+    if (alivePlayers == 0) {
+        LOG_INFO("Server", "All players are dead, DEFEAT");
         sendGameEnded(false);
-        gameEndSent = true;
-        gameEndTimer.restart();
+        setGameState(GAME_ENDED);
         return;
     }
 
-    if (!gameEndSent && lastWaveSpawned) {
-        auto& positions = getComponent<addon::physic::Position2>();
-        int aliveEnemies = 0;
-
-        for (ECS::Entity e = EntityField::ENEMIES_BEGIN;
-             e < EntityField::ENEMIES_END; ++e) {
-            if (e < positions.size() && positions[e].has_value()) {
-                if (e < healths.size() && healths[e].has_value()) {
-                    if (healths[e].value().amount > 0) {
-                        aliveEnemies++;
-                    }
-                }
-            }
-        }
-
-        if (aliveEnemies == 0) {
-            std::cout
-                << "[Server] All enemies defeated! Game Over - VICTORY!\n";
-            sendGameEnded(true);
-            gameEndSent = true;
-            gameEndTimer.restart();
-        }
-    }
-
-    if (gameEndSent && gameEndTimer.checkDelay()) {
-        std::cout << "[Server] Ending game now...\n";
+    // sendRemoved already swept this tick's dead ennemies out of the set
+    if (lastWaveSpawned && _liveEnnemies.size() == 0) {
+        LOG_INFO("Server", "All enemies defeated, VICTORY");
+        sendGameEnded(true);
         setGameState(GAME_ENDED);
-        gameEndSent = false;
     }
 }
 
 void RtypeServer::sendGameEnded(bool victory) {
-    std::vector<uint8_t> packet;
-    packet.push_back(GAME_ENDED);
-    packet.push_back(victory ? 1 : 0);
-
-    std::cout << "[Server] Broadcasting GAME_ENDED ("
-              << (victory ? "VICTORY" : "DEFEAT") << ") to all clients\n";
-    _server.queueBroadcast(packet);
+    LOG_INFO("Server", "Broadcasting GAME_ENDED",
+        {{"result", victory ? "VICTORY" : "DEFEAT"}});
+    message::encode(GameEnded{static_cast<uint8_t>(victory ? 1 : 0)},
+        _packet);
+    queueReliableBroadcast(_packet);
 }
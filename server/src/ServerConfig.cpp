@@ -0,0 +1,127 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** ServerConfig.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include <Logger.hpp>
+#include <ServerConfig.hpp>
+
+static std::string trim(const std::string& str) {
+    std::size_t begin = str.find_first_not_of(" \t\r");
+    if (begin == std::string::npos)
+        return "";
+    std::size_t end = str.find_last_not_of(" \t\r");
+    return str.substr(begin, end - begin + 1);
+}
+
+static std::unordered_map<std::string, double> parseFlatToml(
+    std::ifstream& file) {
+    std::unordered_map<std::string, double> values;
+    std::string section;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+            continue;
+        if (line.front() == '[' && line.back() == ']') {
+            section = trim(line.substr(1, line.size() - 2)) + ".";
+            continue;
+        }
+        std::size_t eq = line.find('=');
+        if (eq == std::string::npos)
+            continue;
+        std::string key = section + trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+        if (value == "true" || value == "false") {
+            values[key] = value == "true" ? 1.0 : 0.0;
+            continue;
+        }
+        try {
+            values[key] = std::stod(value);
+        } catch (const std::exception&) {
+            LOG_WARN("Server", "Config: invalid value", {{"key", key}});
+        }
+    }
+    return values;
+}
+
+template <typename T>
+static void assign(const std::unordered_map<std::string, double>& values,
+    const std::string& key, T& field) {
+    auto it = values.find(key);
+    if (it != values.end())
+        field = static_cast<T>(it->second);
+}
+
+ServerConfig ServerConfig::fromFile(const std::string& path) {
+    ServerConfig config;
+
+    config.load(path);
+    return config;
+}
+
+bool ServerConfig::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        LOG_WARN("Server", "Config not found, using defaults",
+            {{"path", path}});
+        return false;
+    }
+    auto values = parseFlatToml(file);
+
+    assign(values, "rates.updates_time", updates_time);
+    assign(values, "rates.ennemy_spawn_time", ennemy_spawn_time);
+    assign(values, "rates.refresh_players_time", refresh_players_time);
+    assign(values, "rates.refresh_ennemies_time", refresh_ennemies_time);
+    assign(values, "rates.refresh_projectiles_time",
+        refresh_projectiles_time);
+
+    assign(values, "network.bundle_max_size", bundle_max_size);
+    assign(values, "network.metrics_dump_time", metrics_dump_time);
+    assign(values, "network.ping_interval", ping_interval);
+    assign(values, "network.ping_timeout", ping_timeout);
+    assign(values, "network.reliable_resend_time", reliable_resend_time);
+    assign(values, "network.reliable_stall_time", reliable_stall_time);
+    assign(values, "network.session_grace_time", session_grace_time);
+    assign(values, "network.compression_threshold", compression_threshold);
+
+    assign(values, "adaptive.enabled", adaptive.enabled);
+    assign(values, "adaptive.rtt_high", adaptive.rtt_high);
+    assign(values, "adaptive.rtt_low", adaptive.rtt_low);
+    assign(values, "adaptive.loss_high", adaptive.loss_high);
+    assign(values, "adaptive.loss_low", adaptive.loss_low);
+    assign(values, "adaptive.max_divider", adaptive.max_divider);
+    assign(values, "adaptive.healthy_samples", adaptive.healthy_samples);
+    if (adaptive.max_divider == 0)
+        adaptive.max_divider = 1;
+
+    assign(values, "ingress.shot_rate", ingress.shot_rate);
+    assign(values, "ingress.shot_burst", ingress.shot_burst);
+    assign(values, "ingress.event_rate", ingress.event_rate);
+    assign(values, "ingress.event_burst", ingress.event_burst);
+    assign(values, "ingress.link_rate", ingress.link_rate);
+    assign(values, "ingress.link_burst", ingress.link_burst);
+    assign(values, "ingress.control_rate", ingress.control_rate);
+    assign(values, "ingress.control_burst", ingress.control_burst);
+    assign(values, "ingress.handshake_rate", ingress.handshake_rate);
+    assign(values, "ingress.handshake_burst", ingress.handshake_burst);
+
+    assign(values, "spectators.max_spectators", max_spectators);
+    assign(values, "spectators.keyframe_time", spectator_keyframe_time);
+
+    assign(values, "lifecycle.countdown_time", countdown_time);
+    assign(values, "lifecycle.results_time", results_time);
+
+    assign(values, "recorder.seconds", recorder_seconds);
+    assign(values, "recorder.budget_time", recorder_budget_time);
+    assign(values, "recorder.dump_cooldown", recorder_dump_cooldown);
+    return true;
+}
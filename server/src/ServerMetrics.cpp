@@ -0,0 +1,49 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** ServerMetrics.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <ServerMetrics.hpp>
+
+void ServerMetrics::onSend(std::size_t bytes, std::size_t recipients,
+    std::size_t messages) {
+    datagrams_out += recipients;
+    bytes_out += bytes * recipients;
+    messages_out += messages * recipients;
+    totals.datagrams_out += recipients;
+    totals.bytes_out += bytes * recipients;
+    totals.messages_out += messages * recipients;
+}
+
+void ServerMetrics::onCompress(uint8_t code, std::size_t in,
+    std::size_t out, uint64_t micros) {
+    Compression& stats = compression[code];
+
+    stats.packets++;
+    stats.bytes_in += in;
+    stats.bytes_out += out;
+    stats.micros += micros;
+}
+
+void ServerMetrics::onReceive(std::size_t bytes) {
+    datagrams_in++;
+    bytes_in += bytes;
+    totals.datagrams_in++;
+    totals.bytes_in += bytes;
+}
+
+double ServerMetrics::syscallsPerTick() const {
+    if (ticks == 0)
+        return 0.0;
+    return static_cast<double>(datagrams_out + datagrams_in) / ticks;
+}
+
+void ServerMetrics::reset() {
+    Totals kept = totals;
+
+    *this = ServerMetrics();
+    totals = kept;
+}
@@ -19,6 +19,7 @@ int main(int argc, char** argv) {
     uint16_t port = 8080;
     std::string protocol = "UDP";
     size_t max_clients = 4;
+    std::string config_path = SERVER_CONFIG_PATH;
 
     if (argc > 1) {
         port = static_cast<uint16_t>(std::stoi(argv[1]));
@@ -29,8 +30,11 @@ int main(int argc, char** argv) {
     if (argc > 3) {
         max_clients = static_cast<size_t>(std::stoi(argv[3]));
     }
+    if (argc > 4) {
+        config_path = argv[4];
+    }
 
-    RtypeServer server(port, protocol, max_clients);
+    RtypeServer server(port, protocol, max_clients, config_path);
 
     server.run();
     return 0;
@@ -0,0 +1,39 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** FrameArena.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <memory>
+#include <FrameArena.hpp>
+
+FrameArena::FrameArena(std::size_t capacity)
+    : _block(std::make_unique<uint8_t[]>(capacity)), _capacity(capacity) {}
+
+void* FrameArena::allocate(std::size_t size, std::size_t align) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(_block.get());
+    uintptr_t aligned = (base + _used + align - 1) & ~(align - 1);
+    std::size_t end = aligned - base + size;
+
+    if (end <= _capacity) {
+        _used = end;
+        return reinterpret_cast<void*>(aligned);
+    }
+    // new[] of uint8_t is aligned for any fundamental type
+    _overflow.push_back(std::make_unique<uint8_t[]>(size));
+    _overflowed += size + align;
+    return _overflow.back().get();
+}
+
+void FrameArena::reset() {
+    if (!_overflow.empty()) {
+        _capacity = _used + _overflowed;
+        _capacity += _capacity / 2;
+        _block = std::make_unique<uint8_t[]>(_capacity);
+        _overflow.clear();
+        _overflowed = 0;
+    }
+    _used = 0;
+}
@@ -5,12 +5,20 @@
 ** Game.cpp
 */
 
+#include <algorithm>
 #include <string>
+#include <vector>
 #include <clock.hpp>
 #include <ECS/Entity.hpp>
+#include <ECS/Zipper.hpp>
 #include <physic/components/position.hpp>
+#include <physic/components/velocity.hpp>
+#include <entity_spec/components/health.hpp>
+#include <entity_spec/components/damage.hpp>
 
 #include <Game.hpp>
+#include <Snapshot.hpp>
+#include <Wire.hpp>
 #include "waves.hpp"
 
 Game::Game(const std::string& dir) {
@@ -63,3 +71,156 @@ void Game::createProjectile(ECS::Entity e) {
     //         {position[e].value().x + 10, position[e].value().y});
     // }
 }
+
+// Small integer hash, stands in for rand() so the spread is reproducible
+static uint32_t shotHash(std::size_t shooter, uint16_t shot, int pellet) {
+    uint32_t h = static_cast<uint32_t>(shooter) * 2654435761u;
+
+    h ^= (static_cast<uint32_t>(shot) << 8) ^ static_cast<uint32_t>(pellet);
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    h *= 0x297a2d39u;
+    h ^= h >> 15;
+    return h;
+}
+
+ShotEntities Game::createShot(Weapons weapon,
+    std::size_t shooter, uint16_t shot, mat::Vector2f origin,
+    std::size_t& next, std::size_t begin, std::size_t end) {
+    auto& velocities = getComponent<addon::physic::Velocity2>();
+    ShotEntities created;
+    int pellets = weapon == SHOTGUN ? SHOTGUN_PELLETS : 1;
+    float offset = weapon == MINIGUN ? 25.0f : 10.0f;
+
+    for (int i = 0; i < pellets; i++) {
+        if (next < begin || next >= end)
+            next = begin;
+        ECS::Entity e = next++;
+        uint32_t h = shotHash(shooter, shot, i);
+
+        createEntity(e, WEAPONS_NAMES.at(weapon),
+            {origin.x + 60, origin.y + offset});
+        created.entities[created.count++] = e;
+        if (e >= velocities.size() || !velocities[e].has_value())
+            continue;
+        if (weapon == MINIGUN) {
+            velocities[e].value().y += static_cast<float>(h % 120) - 60;
+        } else if (weapon == SHOTGUN) {
+            velocities[e].value().y += static_cast<float>(h % 200) - 100;
+            velocities[e].value().x +=
+                static_cast<float>((h >> 16) % 80) - 40;
+        }
+    }
+    return created;
+}
+
+std::size_t Game::clearField(std::size_t begin, std::size_t end) {
+    auto& positions = getComponent<addon::physic::Position2>();
+    std::size_t last = std::min(end, positions.size());
+    std::size_t removed = 0;
+
+    for (ECS::Entity e = begin; e < last; ++e) {
+        if (!positions[e].has_value())
+            continue;
+        removeEntity(e);
+        removed++;
+    }
+    return removed;
+}
+
+std::size_t Game::clearMatchFields() {
+    return clearField(EntityField::ENEMIES_BEGIN, EntityField::ENEMIES_END)
+        + clearField(EntityField::PROJECTILES_BEGIN,
+            EntityField::PROJECTILES_END)
+        + clearField(EntityField::MAP_BEGIN, EntityField::MAP_END)
+        + clearField(EntityField::PLAYER_BEGIN, EntityField::PLAYER_END);
+}
+
+void Game::setBaseline(ECS::Entity e, const std::string& name,
+    std::optional<mat::Vector2f> pos) {
+    unsetBaseline(e);
+    _baseline.push_back({e, name, pos});
+}
+
+void Game::unsetBaseline(ECS::Entity e) {
+    std::erase_if(_baseline,
+        [e](const BaselineEntity& base) { return base.entity == e; });
+}
+
+void Game::restoreBaseline() {
+    clearMatchFields();
+    for (const auto& base : _baseline) {
+        if (base.pos.has_value())
+            createEntity(base.entity, base.name, base.pos.value());
+        else
+            createEntity(base.entity, base.name);
+    }
+}
+
+void Game::encodePlayersData(std::vector<uint8_t>& packet) {
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto& velocities = getComponent<addon::physic::Velocity2>();
+    auto& healths = getComponent<addon::eSpec::Health>();
+
+    for (auto &&[entity, pos, vel, hp] :
+        ECS::IndexedZipper(positions, velocities, healths)) {
+        if (entity < EntityField::PLAYER_BEGIN ||
+            entity > EntityField::PLAYER_END)
+            continue;
+        snapshot::write(packet, PlayerSnapshot{entity, pos.x, pos.y,
+            vel.x, vel.y, static_cast<int64_t>(hp.amount)});
+    }
+}
+
+void Game::encodeEnnemiesData(std::vector<uint8_t>& packet) {
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto& velocities = getComponent<addon::physic::Velocity2>();
+
+    for (auto &&[entity, pos, vel] :
+        ECS::IndexedZipper(positions, velocities)) {
+        if (entity < EntityField::ENEMIES_BEGIN ||
+            entity >= EntityField::ENEMIES_END)
+            continue;
+        snapshot::write(packet, EnnemySnapshot{entity, pos.x, pos.y,
+            vel.x, vel.y});
+    }
+}
+
+void Game::encodeProjectilesData(std::vector<uint8_t>& packet) {
+    auto& positions = getComponent<addon::physic::Position2>();
+    auto& velocities = getComponent<addon::physic::Velocity2>();
+    auto& damages = getComponent<addon::eSpec::Damage>();
+
+    for (auto &&[entity, pos, vel, dmg] :
+        ECS::IndexedZipper(positions, velocities, damages)) {
+        if (entity < EntityField::PROJECTILES_BEGIN ||
+            entity >= EntityField::PROJECTILES_END)
+            continue;
+        Weapons weapon = MINIGUN;
+        if (dmg.amount == 10)
+            weapon = ROCKET;
+        else if (dmg.amount == 3)
+            weapon = SHOTGUN;
+        snapshot::write(packet, ProjectileSnapshot{entity, pos.x, pos.y,
+            vel.x, vel.y, static_cast<std::size_t>(weapon)});
+    }
+}
+
+void Game::encodeKeyframe(std::vector<uint8_t>& packet, std::size_t waves) {
+    uint32_t spawned = static_cast<uint32_t>(waves);
+    std::size_t section;
+
+    packet.push_back(getGameState());
+    packet.resize(packet.size() + sizeof(uint32_t));
+    wire::put(packet.data() + packet.size() - sizeof(uint32_t), spawned);
+    section = snapshot::beginSection(packet);
+    encodePlayersData(packet);
+    snapshot::endSection(packet, section);
+    section = snapshot::beginSection(packet);
+    encodeEnnemiesData(packet);
+    snapshot::endSection(packet, section);
+    section = snapshot::beginSection(packet);
+    encodeProjectilesData(packet);
+    snapshot::endSection(packet, section);
+}
@@ -0,0 +1,104 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** LinkStats.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <Protocol.hpp>
+#include <Wire.hpp>
+#include <LinkStats.hpp>
+
+static constexpr float RTT_GAIN = 1.0f / 8.0f;      // RFC 6298
+static constexpr float JITTER_GAIN = 1.0f / 16.0f;  // RFC 3550
+static constexpr float LOSS_GAIN = 1.0f / 16.0f;
+static constexpr std::size_t PING_PAYLOAD_SIZE = LINK_PING_SIZE;
+static_assert(PING_PAYLOAD_SIZE == sizeof(uint32_t) + sizeof(int64_t));
+static constexpr std::size_t MAX_PENDING_PINGS = 64;
+
+LinkStats::LinkStats(float timeout_ms) : _timeout_ms(timeout_ms) {
+    _pending.reserve(MAX_PENDING_PINGS);
+}
+
+void LinkStats::makePing(std::vector<uint8_t>& packet) {
+    auto now = Clock::now();
+    uint32_t seq = _next_seq++;
+    int64_t stamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        now.time_since_epoch()).count();
+
+    packet.resize(1 + PING_PAYLOAD_SIZE);
+    packet[0] = PING;
+    wire::put(wire::put(packet.data() + 1, seq), stamp);
+
+    if (_pending.size() >= MAX_PENDING_PINGS) {
+        _pending.erase(_pending.begin());
+        onOutcome(true);
+    }
+    _pending.push_back({seq, now});
+    _sent++;
+}
+
+void LinkStats::makePong(const std::vector<uint8_t>& ping,
+    std::vector<uint8_t>& packet) {
+    packet.resize(1);
+    packet[0] = PONG;
+    packet.insert(packet.end(), ping.begin(), ping.end());
+}
+
+bool LinkStats::onPong(const std::vector<uint8_t>& data) {
+    if (data.size() < PING_PAYLOAD_SIZE)
+        return false;
+    uint32_t seq;
+    wire::get(data.data(), seq);
+
+    for (auto it = _pending.begin(); it != _pending.end(); ++it) {
+        if (it->seq != seq)
+            continue;
+        float rtt = std::chrono::duration<float, std::milli>(
+            Clock::now() - it->sent).count();
+        _pending.erase(it);
+
+        if (_samples == 0) {
+            _srtt = rtt;
+            _jitter = rtt / 2.0f;
+        } else {
+            _jitter += (std::fabs(rtt - _last_rtt) - _jitter) * JITTER_GAIN;
+            _srtt += (rtt - _srtt) * RTT_GAIN;
+        }
+        _last_rtt = rtt;
+        _samples++;
+        onOutcome(false);
+        return true;
+    }
+    return false;
+}
+
+void LinkStats::checkTimeouts() {
+    auto now = Clock::now();
+    auto expired = _pending.begin();
+
+    while (expired != _pending.end()) {
+        float age = std::chrono::duration<float, std::milli>(
+            now - expired->sent).count();
+        if (age < _timeout_ms)
+            break;
+        expired++;
+        onOutcome(true);
+    }
+    _pending.erase(_pending.begin(), expired);
+}
+
+void LinkStats::onOutcome(bool lost) {
+    if (lost)
+        _lost++;
+    _loss += ((lost ? 1.0f : 0.0f) - _loss) * LOSS_GAIN;
+}
+
+void LinkStats::reset() {
+    *this = LinkStats(_timeout_ms);
+}
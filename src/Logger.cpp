@@ -0,0 +1,182 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** Logger.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <initializer_list>
+#include <string_view>
+#include <thread>
+
+#include <Logger.hpp>
+
+static_assert((LOG_QUEUE_SIZE & (LOG_QUEUE_SIZE - 1)) == 0,
+    "LOG_QUEUE_SIZE must be a power of two");
+
+static constexpr auto LOG_IDLE_SLEEP = std::chrono::milliseconds(2);
+
+static const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warn: return "WARN";
+        default: return "ERROR";
+    }
+}
+
+static std::size_t copyText(char* buf, std::size_t size,
+    std::string_view text) {
+    std::size_t len = std::min(text.size(), size);
+    std::memcpy(buf, text.data(), len);
+    return len;
+}
+
+std::size_t LogField::format(char* buf, std::size_t size) const {
+    if (size < 2)
+        return 0;
+    std::size_t len = 0;
+    int res = 0;
+
+    buf[len++] = ' ';
+    len += copyText(buf + len, size - len - 1, _key);
+    buf[len++] = '=';
+    switch (_kind) {
+        case SIGNED:
+            res = std::snprintf(buf + len, size - len, "%lld",
+                static_cast<long long>(_signed));  // NOLINT
+            break;
+        case UNSIGNED:
+            res = std::snprintf(buf + len, size - len, "%llu",
+                static_cast<unsigned long long>(_unsigned));  // NOLINT
+            break;
+        case REAL:
+            res = std::snprintf(buf + len, size - len, "%.3f", _real);
+            break;
+        case TEXT:
+            return len + copyText(buf + len, size - len, _text);
+    }
+    if (res < 0)
+        return len;
+    return std::min(len + static_cast<std::size_t>(res), size);
+}
+
+Logger& Logger::get() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger() {
+    for (std::size_t i = 0; i < LOG_QUEUE_SIZE; ++i)
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    _writer = std::thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger() {
+    _running = false;
+    if (_writer.joinable())
+        _writer.join();
+}
+
+void Logger::write(LogLevel level, std::string_view tag,
+    std::string_view message, std::initializer_list<LogField> fields) {
+    std::size_t pos = _enqueue.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+
+    while (true) {
+        cell = &_cells[pos & (LOG_QUEUE_SIZE - 1)];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) -
+            static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (_enqueue.compare_exchange_weak(pos, pos + 1,
+                std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = _enqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    Record& record = cell->record;
+    record.level = level;
+    record.time = std::chrono::system_clock::now();
+    std::size_t tag_len = copyText(record.tag, LOG_TAG_SIZE - 1, tag);
+    record.tag[tag_len] = '\0';
+    record.length = copyText(record.text, LOG_RECORD_SIZE, message);
+    for (const auto& field : fields) {
+        record.length += field.format(record.text + record.length,
+            LOG_RECORD_SIZE - record.length);
+    }
+    cell->sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool Logger::pop(Record& record) {
+    std::size_t pos = _dequeue.load(std::memory_order_relaxed);
+    Cell& cell = _cells[pos & (LOG_QUEUE_SIZE - 1)];
+
+    if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+        return false;
+    record = cell.record;
+    cell.sequence.store(pos + LOG_QUEUE_SIZE, std::memory_order_release);
+    _dequeue.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void Logger::writeRecord(const Record& record) const {
+    std::time_t seconds = std::chrono::system_clock::to_time_t(record.time);
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        record.time.time_since_epoch()).count() % 1000;
+    std::tm local{};
+    localtime_r(&seconds, &local);
+
+    FILE* out = record.level >= LogLevel::Warn ? stderr : stdout;
+    std::fprintf(out, "%02d:%02d:%02d.%03d %-5s [%s] %.*s\n",
+        local.tm_hour, local.tm_min, local.tm_sec, static_cast<int>(millis),
+        levelName(record.level), record.tag,
+        static_cast<int>(record.length), record.text);
+}
+
+void Logger::writerLoop() {
+    Record record;
+    uint64_t reported_drops = 0;
+
+    while (true) {
+        bool wrote = false;
+        while (pop(record)) {
+            writeRecord(record);
+            _written.fetch_add(1, std::memory_order_release);
+            wrote = true;
+        }
+        uint64_t drops = _dropped.load(std::memory_order_relaxed);
+        if (drops != reported_drops) {
+            std::fprintf(stderr, "[Logger] %llu records dropped\n",
+                static_cast<unsigned long long>(  // NOLINT
+                    drops - reported_drops));
+            reported_drops = drops;
+        }
+        if (wrote) {
+            std::fflush(stdout);
+            std::fflush(stderr);
+        } else if (!_running) {
+            return;
+        } else {
+            std::this_thread::sleep_for(LOG_IDLE_SLEEP);
+        }
+    }
+}
+
+void Logger::flush() {
+    std::size_t target = _enqueue.load(std::memory_order_acquire);
+
+    while (_dequeue.load(std::memory_order_acquire) < target && _running)
+        std::this_thread::sleep_for(LOG_IDLE_SLEEP);
+}
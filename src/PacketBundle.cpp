@@ -0,0 +1,67 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** PacketBundle.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <Protocol.hpp>
+#include <Wire.hpp>
+#include <PacketBundle.hpp>
+
+static constexpr std::size_t ENTRY_HEADER_SIZE = 1 + sizeof(uint16_t);
+
+PacketBundle::PacketBundle(std::size_t max_size) : _max_size(max_size) {
+    _data.reserve(max_size);
+    _data.push_back(BUNDLE);
+}
+
+bool PacketBundle::fits(const std::vector<uint8_t>& packet) const {
+    if (packet.empty())
+        return false;
+    std::size_t payload = packet.size() - 1;
+    if (payload > std::numeric_limits<uint16_t>::max())
+        return false;
+    return _data.size() + ENTRY_HEADER_SIZE + payload <= _max_size;
+}
+
+bool PacketBundle::add(const std::vector<uint8_t>& packet) {
+    if (!fits(packet))
+        return false;
+    uint16_t payload = static_cast<uint16_t>(packet.size() - 1);
+
+    _data.push_back(packet[0]);
+    _data.resize(_data.size() + sizeof(uint16_t));
+    wire::put(_data.data() + _data.size() - sizeof(uint16_t), payload);
+    _data.insert(_data.end(), packet.begin() + 1, packet.end());
+    _count++;
+    return true;
+}
+
+void PacketBundle::clear() {
+    _data.resize(1);
+    _count = 0;
+}
+
+bool PacketBundle::unpack(const std::vector<uint8_t>& data,
+    std::vector<uint8_t>& payload, const Handler& handler) {
+    std::size_t follow = 0;
+
+    while (follow + ENTRY_HEADER_SIZE <= data.size()) {
+        uint8_t code = data[follow];
+        uint16_t size;
+        wire::get(data.data() + follow + 1, size);
+        follow += ENTRY_HEADER_SIZE;
+        if (follow + size > data.size())
+            return false;
+        payload.assign(data.begin() + follow, data.begin() + follow + size);
+        follow += size;
+        handler(code, payload);
+    }
+    return follow == data.size();
+}
@@ -0,0 +1,161 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** PacketCodec.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <Protocol.hpp>
+#include <Wire.hpp>
+#include <PacketCodec.hpp>
+
+static constexpr std::size_t MIN_MATCH = 4;
+static constexpr std::size_t MAX_MATCH = MIN_MATCH + 0x7f;
+static constexpr std::size_t MAX_LITERALS = 0x80;
+static constexpr std::size_t MAX_DISTANCE = 0xffff;
+static constexpr std::size_t HASH_BITS = 12;
+static constexpr std::size_t HEADER_SIZE =
+    1 + sizeof(uint16_t) + sizeof(uint8_t);
+static constexpr uint8_t FLAG_DICT = 0x01;
+
+static uint32_t hash4(const uint8_t* p) {
+    uint32_t v;
+
+    std::memcpy(&v, p, sizeof(uint32_t));
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static void flushLiterals(std::vector<uint8_t>& out, const uint8_t* begin,
+    const uint8_t* end) {
+    while (begin < end) {
+        std::size_t run = std::min<std::size_t>(end - begin, MAX_LITERALS);
+        out.push_back(static_cast<uint8_t>(run - 1));
+        out.insert(out.end(), begin, begin + run);
+        begin += run;
+    }
+}
+
+bool PacketCodec::loadDictionary(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open())
+        return false;
+    std::vector<uint8_t> dict((std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    // Only the tail is in reach of the 2B distances anyway
+    if (dict.size() > COMPRESSION_MAX_DICT)
+        dict.erase(dict.begin(), dict.end() - COMPRESSION_MAX_DICT);
+    _dict = std::move(dict);
+    return !_dict.empty();
+}
+
+bool PacketCodec::compress(const std::vector<uint8_t>& packet,
+    std::vector<uint8_t>& out) {
+    if (packet.size() > UINT16_MAX || packet.size() < MIN_MATCH)
+        return false;
+
+    // History is dictionary + packet, only the packet part is emitted
+    _history.assign(_dict.begin(), _dict.end());
+    _history.insert(_history.end(), packet.begin(), packet.end());
+    const uint8_t* base = _history.data();
+    const uint8_t* end = base + _history.size();
+    const uint8_t* ip = base + _dict.size();
+    const uint8_t* literals = ip;
+
+    std::array<int32_t, 1 << HASH_BITS> table;
+    table.fill(-1);
+    for (std::size_t i = 0; i + MIN_MATCH <= _dict.size(); ++i)
+        table[hash4(base + i)] = static_cast<int32_t>(i);
+
+    uint16_t raw = static_cast<uint16_t>(packet.size());
+    out.resize(1 + sizeof(uint16_t));
+    out[0] = COMPRESSED;
+    wire::put(out.data() + 1, raw);
+    out.push_back(_dict.empty() ? 0 : FLAG_DICT);
+
+    while (ip + MIN_MATCH <= end) {
+        uint32_t h = hash4(ip);
+        int32_t candidate = table[h];
+        table[h] = static_cast<int32_t>(ip - base);
+        if (candidate < 0 ||
+            static_cast<std::size_t>((ip - base) - candidate) > MAX_DISTANCE ||
+            std::memcmp(base + candidate, ip, MIN_MATCH) != 0) {
+            ip++;
+            continue;
+        }
+        std::size_t len = MIN_MATCH;
+        while (len < MAX_MATCH && ip + len < end &&
+            base[candidate + len] == ip[len])
+            len++;
+
+        flushLiterals(out, literals, ip);
+        out.push_back(static_cast<uint8_t>(0x80 | (len - MIN_MATCH)));
+        uint16_t dist = static_cast<uint16_t>((ip - base) - candidate);
+        out.resize(out.size() + sizeof(uint16_t));
+        wire::put(out.data() + out.size() - sizeof(uint16_t), dist);
+        ip += len;
+        literals = ip;
+        if (out.size() >= packet.size())
+            return false;
+    }
+    flushLiterals(out, literals, end);
+    return out.size() < packet.size();
+}
+
+bool PacketCodec::decompress(const std::vector<uint8_t>& data,
+    std::vector<uint8_t>& packet) {
+    if (data.size() < HEADER_SIZE - 1)
+        return false;
+    uint16_t raw;
+    wire::get(data.data(), raw);
+    bool with_dict = data[sizeof(uint16_t)] & FLAG_DICT;
+    if (with_dict && _dict.empty())
+        return false;
+
+    std::vector<uint8_t>& history = _history;
+    std::size_t start = with_dict ? _dict.size() : 0;
+    history.clear();
+    history.reserve(start + raw);
+    if (with_dict)
+        history.insert(history.end(), _dict.begin(), _dict.end());
+
+    std::size_t i = HEADER_SIZE - 1;
+    while (i < data.size()) {
+        uint8_t op = data[i++];
+        if (op < 0x80) {
+            std::size_t run = op + 1;
+            if (i + run > data.size() || history.size() - start + run > raw)
+                return false;
+            history.insert(history.end(), data.begin() + i,
+                data.begin() + i + run);
+            i += run;
+            continue;
+        }
+        if (i + sizeof(uint16_t) > data.size())
+            return false;
+        uint16_t dist;
+        wire::get(data.data() + i, dist);
+        i += sizeof(uint16_t);
+        std::size_t len = (op & 0x7f) + MIN_MATCH;
+        if (dist == 0 || dist > history.size() ||
+            history.size() - start + len > raw)
+            return false;
+        // Byte by byte, a match may overlap the bytes it produces
+        std::size_t from = history.size() - dist;
+        for (std::size_t k = 0; k < len; ++k)
+            history.push_back(history[from + k]);
+    }
+    if (history.size() - start != raw)
+        return false;
+    packet.assign(history.begin() + start, history.end());
+    return true;
+}
@@ -0,0 +1,165 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** ReliableChannel.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include <Protocol.hpp>
+#include <Wire.hpp>
+#include <ReliableChannel.hpp>
+
+// Signed distance from b to a, handles the 16 bits wrap around
+static int16_t seqDistance(uint16_t a, uint16_t b) {
+    return static_cast<int16_t>(static_cast<uint16_t>(a - b));
+}
+
+const std::vector<uint8_t>* ReliableChannel::wrap(
+    const std::vector<uint8_t>& packet) {
+    if (!_queued.empty() || _pending.size() >= RELIABLE_WINDOW) {
+        _queued.push_back(takeSpare());
+        _queued.back().assign(packet.begin(), packet.end());
+        return nullptr;
+    }
+    return &sequence(packet);
+}
+
+void ReliableChannel::release(const Sender& send) {
+    while (!_queued.empty() && _pending.size() < RELIABLE_WINDOW) {
+        send(sequence(_queued.front()));
+        _spare.push_back(std::move(_queued.front()));
+        _queued.pop_front();
+    }
+}
+
+float ReliableChannel::stalled() const {
+    if (!_full_since.has_value())
+        return 0.0f;
+    return std::chrono::duration<float, std::milli>(
+        Clock::now() - _full_since.value()).count();
+}
+
+const std::vector<uint8_t>& ReliableChannel::sequence(
+    const std::vector<uint8_t>& packet) {
+    std::vector<uint8_t> wrapped = takeSpare();
+    uint16_t seq = _next_seq++;
+
+    wrapped.resize(1 + sizeof(uint16_t));
+    wrapped[0] = RELIABLE;
+    wire::put(wrapped.data() + 1, seq);
+    wrapped.insert(wrapped.end(), packet.begin(), packet.end());
+    _pending.push_back({seq, std::move(wrapped), Clock::now()});
+    if (_pending.size() >= RELIABLE_WINDOW && !_full_since.has_value())
+        _full_since = Clock::now();
+    return _pending.back().packet;
+}
+
+std::vector<uint8_t> ReliableChannel::takeSpare() {
+    std::vector<uint8_t> buffer;
+
+    if (!_spare.empty()) {
+        buffer = std::move(_spare.back());
+        _spare.pop_back();
+    }
+    return buffer;
+}
+
+void ReliableChannel::onAck(const Ack& msg) {
+    uint16_t ack = msg.ack;
+    uint32_t bits = msg.bits;
+    std::size_t kept = 0;
+
+    // Compacts in place so that the oldest message stays first
+    for (std::size_t i = 0; i < _pending.size(); ++i) {
+        int16_t dist = seqDistance(_pending[i].seq, ack);
+        bool acked = dist <= 0 ||
+            (dist >= 2 && dist < 34 && (bits >> (dist - 2)) & 1u);
+        if (acked)
+            _spare.push_back(std::move(_pending[i].packet));
+        else if (kept++ != i)
+            _pending[kept - 1] = std::move(_pending[i]);
+    }
+    _pending.erase(_pending.begin() + kept, _pending.end());
+    if (_pending.size() < RELIABLE_WINDOW)
+        _full_since.reset();
+}
+
+void ReliableChannel::resends(float timeout_ms, const Sender& send) {
+    auto now = Clock::now();
+    auto timeout = std::chrono::duration<float, std::milli>(timeout_ms);
+
+    for (auto& msg : _pending) {
+        if (now - msg.sent < timeout)
+            continue;
+        msg.sent = now;
+        send(msg.packet);
+    }
+}
+
+const std::vector<uint8_t>& ReliableChannel::receive(
+    const std::vector<uint8_t>& data, const Handler& handler) {
+    if (data.size() < sizeof(uint16_t) + 1) {
+        makeAck();
+        return _ack;
+    }
+    uint16_t seq;
+    wire::get(data.data(), seq);
+    int16_t dist = seqDistance(seq, _next_expected);
+
+    if (dist < 0 || dist >= RELIABLE_WINDOW) {
+        makeAck();
+        return _ack;
+    }
+    if (dist > 0) {
+        _buffered.emplace(seq, std::vector<uint8_t>(
+            data.begin() + sizeof(uint16_t), data.end()));
+        makeAck();
+        return _ack;
+    }
+
+    deliver(data.data() + sizeof(uint16_t), data.size() - sizeof(uint16_t),
+        handler);
+    _next_expected++;
+    for (auto it = _buffered.find(_next_expected); it != _buffered.end();
+         it = _buffered.find(_next_expected)) {
+        deliver(it->second.data(), it->second.size(), handler);
+        _buffered.erase(it);
+        _next_expected++;
+    }
+    makeAck();
+    return _ack;
+}
+
+void ReliableChannel::reset() {
+    _next_seq = 0;
+    for (auto& msg : _pending)
+        _spare.push_back(std::move(msg.packet));
+    _pending.clear();
+    for (auto& packet : _queued)
+        _spare.push_back(std::move(packet));
+    _queued.clear();
+    _full_since.reset();
+    _next_expected = 0;
+    _buffered.clear();
+}
+
+void ReliableChannel::makeAck() {
+    Ack msg{static_cast<uint16_t>(_next_expected - 1), 0};
+
+    for (uint16_t i = 0; i < 32; ++i) {
+        if (_buffered.contains(static_cast<uint16_t>(_next_expected + 1 + i)))
+            msg.bits |= 1u << i;
+    }
+    message::encode(msg, _ack);
+}
+
+void ReliableChannel::deliver(const uint8_t* packet, std::size_t size,
+    const Handler& handler) {
+    _payload.assign(packet + 1, packet + size);
+    handler(packet[0], _payload);
+}
@@ -0,0 +1,159 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** Snapshot.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <Wire.hpp>
+#include <Snapshot.hpp>
+
+static uint8_t* grow(std::vector<uint8_t>& packet, std::size_t size) {
+    std::size_t offset = packet.size();
+
+    packet.resize(offset + size);
+    return packet.data() + offset;
+}
+
+// Whole rows only, one size check per packet
+template <typename Row, typename Alloc>
+static bool readRows(const std::vector<uint8_t>& data,
+    std::vector<Row, Alloc>& rows) {
+    std::size_t count = data.size() / message::size<Row>();
+    const uint8_t* in = data.data();
+
+    rows.reserve(rows.size() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        Row row;
+        in = message::get(in, row);
+        rows.push_back(row);
+    }
+    return data.size() % message::size<Row>() == 0;
+}
+
+namespace snapshot {
+
+void write(std::vector<uint8_t>& packet, const PlayerSnapshot& row) {
+    message::put(grow(packet, message::size<PlayerSnapshot>()), row);
+}
+
+void write(std::vector<uint8_t>& packet, const EnnemySnapshot& row) {
+    message::put(grow(packet, message::size<EnnemySnapshot>()), row);
+}
+
+void write(std::vector<uint8_t>& packet, const ProjectileSnapshot& row) {
+    message::put(grow(packet, message::size<ProjectileSnapshot>()), row);
+}
+
+void write(std::vector<uint8_t>& packet, const ShotSnapshot& row) {
+    message::put(grow(packet, message::size<ShotSnapshot>()), row);
+}
+
+void write(std::vector<uint8_t>& packet, std::size_t entity) {
+    wire::put(grow(packet, sizeof(std::size_t)), entity);
+}
+
+template <typename Alloc>
+bool read(const std::vector<uint8_t>& data,
+    std::vector<PlayerSnapshot, Alloc>& rows) {
+    return readRows(data, rows);
+}
+
+template <typename Alloc>
+bool read(const std::vector<uint8_t>& data,
+    std::vector<EnnemySnapshot, Alloc>& rows) {
+    return readRows(data, rows);
+}
+
+template <typename Alloc>
+bool read(const std::vector<uint8_t>& data,
+    std::vector<ProjectileSnapshot, Alloc>& rows) {
+    return readRows(data, rows);
+}
+
+std::size_t beginSection(std::vector<uint8_t>& packet) {
+    std::size_t section = packet.size();
+
+    grow(packet, sizeof(uint32_t));
+    return section;
+}
+
+void endSection(std::vector<uint8_t>& packet, std::size_t section) {
+    uint32_t size = packet.size() - section - sizeof(uint32_t);
+
+    wire::put(packet.data() + section, size);
+}
+
+static bool readSection(const uint8_t*& in, const uint8_t* end,
+    std::vector<uint8_t>& section) {
+    uint32_t size;
+
+    if (end - in < static_cast<std::ptrdiff_t>(sizeof(uint32_t)))
+        return false;
+    in = wire::get(in, size);
+    if (end - in < static_cast<std::ptrdiff_t>(size))
+        return false;
+    section.assign(in, in + size);
+    in += size;
+    return true;
+}
+
+bool read(const std::vector<uint8_t>& data, Keyframe& frame) {
+    const uint8_t* in = data.data();
+    const uint8_t* end = data.data() + data.size();
+
+    if (data.size() < sizeof(uint8_t) + sizeof(uint32_t))
+        return false;
+    in = wire::get(in, frame.state);
+    in = wire::get(in, frame.waves);
+    return readSection(in, end, frame.players)
+        && readSection(in, end, frame.ennemies)
+        && readSection(in, end, frame.projectiles);
+}
+
+bool read(const std::vector<uint8_t>& data, ShotSnapshot& row) {
+    if (data.size() < message::size<ShotSnapshot>())
+        return false;
+    message::get(data.data(), row);
+    return true;
+}
+
+template <typename Alloc>
+bool read(const std::vector<uint8_t>& data,
+    std::vector<std::size_t, Alloc>& rows) {
+    std::size_t count = data.size() / sizeof(std::size_t);
+    const uint8_t* in = data.data();
+
+    rows.reserve(rows.size() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t entity;
+        in = wire::get(in, entity);
+        rows.push_back(entity);
+    }
+    return data.size() % sizeof(std::size_t) == 0;
+}
+
+template bool read(const std::vector<uint8_t>&,
+    std::vector<PlayerSnapshot>&);
+template bool read(const std::vector<uint8_t>&,
+    FrameVector<PlayerSnapshot>&);
+template bool read(const std::vector<uint8_t>&,
+    std::vector<EnnemySnapshot>&);
+template bool read(const std::vector<uint8_t>&,
+    FrameVector<EnnemySnapshot>&);
+template bool read(const std::vector<uint8_t>&,
+    std::vector<ProjectileSnapshot>&);
+template bool read(const std::vector<uint8_t>&,
+    FrameVector<ProjectileSnapshot>&);
+template bool read(const std::vector<uint8_t>&,
+    std::vector<std::size_t>&);
+template bool read(const std::vector<uint8_t>&,
+    FrameVector<std::size_t>&);
+
+}  // namespace snapshot
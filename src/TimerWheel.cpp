@@ -0,0 +1,145 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** TimerWheel.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <chrono>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <TimerWheel.hpp>
+
+static constexpr uint64_t SLOT_MASK = (1 << TIMER_WHEEL_BITS) - 1;
+
+TimerWheel::TimerWheel(float tick)
+    : _tick(std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(tick > 0.0f ? tick : 0.001f)))
+    , _origin(Clock::now()) {}
+
+TimerWheel::Id TimerWheel::after(float seconds, Callback callback) {
+    return schedule(seconds, false, std::move(callback));
+}
+
+TimerWheel::Id TimerWheel::every(float seconds, Callback callback) {
+    return schedule(seconds, true, std::move(callback));
+}
+
+TimerWheel::Id TimerWheel::schedule(float seconds, bool repeat,
+    Callback callback) {
+    float tick = std::chrono::duration<float>(_tick).count();
+    uint64_t ticks = static_cast<uint64_t>(std::ceil(seconds / tick));
+    uint32_t index;
+
+    if (ticks == 0)
+        ticks = 1;
+    if (_free.empty()) {
+        index = static_cast<uint32_t>(_timers.size());
+        _timers.emplace_back();
+    } else {
+        index = _free.back();
+        _free.pop_back();
+    }
+    Timer& timer = _timers[index];
+    timer.when = _now + ticks;
+    timer.period = repeat ? ticks : 0;
+    timer.active = true;
+    timer.callback = std::move(callback);
+    _pending++;
+    insert(index);
+    return (static_cast<Id>(timer.generation) << 32) | index;
+}
+
+void TimerWheel::cancel(Id id) {
+    uint32_t index = static_cast<uint32_t>(id);
+
+    if (index >= _timers.size())
+        return;
+    Timer& timer = _timers[index];
+    if (timer.generation != (id >> 32) || !timer.active)
+        return;
+    // Its slot still holds the index, it is released when visited
+    timer.active = false;
+    _pending--;
+}
+
+void TimerWheel::insert(uint32_t index) {
+    uint64_t when = _timers[index].when;
+    uint64_t delta = when - _now;
+    std::size_t level = 0;
+
+    while (level + 1 < TIMER_WHEEL_LEVELS &&
+        delta >= (uint64_t{1} << (TIMER_WHEEL_BITS * (level + 1))))
+        level++;
+    // Too far for the wheel: park it in the last slot in reach, it goes
+    // back up when that slot cascades
+    if (delta >> (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))
+        when = _now + (uint64_t{1} <<
+            (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1;
+    _wheel[level][(when >> (TIMER_WHEEL_BITS * level)) & SLOT_MASK]
+        .push_back(index);
+}
+
+void TimerWheel::release(uint32_t index) {
+    Timer& timer = _timers[index];
+
+    timer.active = false;
+    timer.callback = nullptr;
+    timer.generation++;
+    _free.push_back(index);
+}
+
+void TimerWheel::cascade(std::size_t level) {
+    Slot timers;
+
+    timers.swap(_wheel[level][(_now >> (TIMER_WHEEL_BITS * level))
+        & SLOT_MASK]);
+    for (uint32_t index : timers) {
+        if (_timers[index].active)
+            insert(index);
+        else
+            release(index);
+    }
+}
+
+void TimerWheel::step() {
+    std::size_t top = 0;
+    Slot due;
+
+    _now++;
+    // Higher levels first, they may refill the lower slot being cascaded
+    while (top + 1 < TIMER_WHEEL_LEVELS &&
+        (_now & ((uint64_t{1} << (TIMER_WHEEL_BITS * (top + 1))) - 1)) == 0)
+        top++;
+    for (std::size_t level = top; level > 0; --level)
+        cascade(level);
+
+    due.swap(_wheel[0][_now & SLOT_MASK]);
+    for (uint32_t index : due) {
+        Timer& timer = _timers[index];
+        if (!timer.active) {
+            release(index);
+            continue;
+        }
+        if (timer.period == 0) {
+            Callback callback = std::move(timer.callback);
+            _pending--;
+            release(index);
+            callback();
+            continue;
+        }
+        timer.when = _now + timer.period;
+        insert(index);
+        // _timers is a deque, new timers do not move this one
+        timer.callback();
+    }
+}
+
+void TimerWheel::advance(Clock::time_point now) {
+    uint64_t target = static_cast<uint64_t>((now - _origin) / _tick);
+
+    while (_now < target)
+        step();
+}
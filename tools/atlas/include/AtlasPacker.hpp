@@ -0,0 +1,50 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** AtlasPacker.hpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define ATLAS_WIDTH 1024                // pixels, height grows as needed
+#define ATLAS_IMAGE "atlas.png"
+
+// Packs the sprite sheets referenced by sprite TOMLs into one texture.
+// Each sheet is placed on a multiple of its own frame size, so the
+// engine's frame coordinates ([[column, row], ...]) only need an offset
+// and the sprite format stays the same.
+class AtlasPacker {
+ public:
+    explicit AtlasPacker(const std::string& out_dir);
+
+    // Collects the `path` / `size` pairs of a sprite TOML
+    bool addConfig(const std::string& toml);
+    // Packs and writes the atlas image, then one rewritten TOML per input
+    bool write();
+
+ private:
+    struct Sheet {
+        std::string path;
+        unsigned frame_w = 0;
+        unsigned frame_h = 0;
+        unsigned width = 0;
+        unsigned height = 0;
+        unsigned x = 0;
+        unsigned y = 0;
+        bool packed = false;
+    };
+
+    std::string _out_dir;
+    std::vector<std::string> _configs;
+    std::unordered_map<std::string, Sheet> _sheets;
+
+    unsigned pack();
+    bool writeConfig(const std::string& toml) const;
+};
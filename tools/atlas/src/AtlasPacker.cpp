@@ -0,0 +1,174 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** AtlasPacker.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+#include <SFML/Graphics/Image.hpp>
+
+#include <AtlasPacker.hpp>
+
+static const std::regex PATH_LINE(R"((\s*path\s*=\s*")([^"]+)(".*))");
+static const std::regex SIZE_LINE(
+    R"(\s*size\s*=\s*\[\s*(\d+)\s*,\s*(\d+)\s*\].*)");
+static const std::regex FRAME_COORDS(R"(\[\[\s*(\d+)\s*,\s*(\d+)\s*\])");
+
+static std::string normalize(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().string();
+}
+
+static unsigned alignUp(unsigned value, unsigned step) {
+    return (value + step - 1) / step * step;
+}
+
+AtlasPacker::AtlasPacker(const std::string& out_dir) : _out_dir(out_dir) {}
+
+bool AtlasPacker::addConfig(const std::string& toml) {
+    std::ifstream file(toml);
+    if (!file.is_open()) {
+        std::cerr << "atlas: cannot open " << toml << "\n";
+        return false;
+    }
+    std::string line;
+    std::string image;
+    std::smatch match;
+
+    while (std::getline(file, line)) {
+        if (std::regex_match(line, match, PATH_LINE)) {
+            image = normalize(match[2]);
+        } else if (!image.empty() && std::regex_match(line, match, SIZE_LINE)) {
+            unsigned w = std::stoul(match[1]);
+            unsigned h = std::stoul(match[2]);
+            auto [it, added] = _sheets.try_emplace(image);
+            if (added) {
+                it->second.path = image;
+                it->second.frame_w = w;
+                it->second.frame_h = h;
+            } else if (it->second.frame_w != w || it->second.frame_h != h) {
+                std::cerr << "atlas: " << image
+                    << " used with two frame sizes, left out\n";
+                it->second.frame_w = 0;
+            }
+            image.clear();
+        }
+    }
+    _configs.push_back(toml);
+    return true;
+}
+
+// Shelf packing, largest sheets first, every sheet aligned on its grid
+unsigned AtlasPacker::pack() {
+    std::vector<Sheet*> order;
+
+    for (auto& [path, sheet] : _sheets) {
+        if (sheet.frame_w > 0 && sheet.width > 0 && sheet.width <= ATLAS_WIDTH)
+            order.push_back(&sheet);
+    }
+    std::sort(order.begin(), order.end(), [](Sheet* a, Sheet* b) {
+        return a->height > b->height;
+    });
+
+    unsigned shelf_y = 0;
+    unsigned shelf_bottom = 0;
+    unsigned cursor_x = 0;
+    for (Sheet* sheet : order) {
+        unsigned x = alignUp(cursor_x, sheet->frame_w);
+        if (x + sheet->width > ATLAS_WIDTH) {
+            shelf_y = shelf_bottom;
+            x = 0;
+        }
+        unsigned y = alignUp(shelf_y, sheet->frame_h);
+        sheet->x = x;
+        sheet->y = y;
+        sheet->packed = true;
+        cursor_x = x + sheet->width;
+        shelf_bottom = std::max(shelf_bottom, y + sheet->height);
+    }
+    return shelf_bottom;
+}
+
+bool AtlasPacker::write() {
+    std::unordered_map<std::string, sf::Image> images;
+
+    for (auto& [path, sheet] : _sheets) {
+        if (sheet.frame_w == 0 || !images[path].loadFromFile(path)) {
+            std::cerr << "atlas: " << path << " left out\n";
+            sheet.frame_w = 0;
+            continue;
+        }
+        sheet.width = images[path].getSize().x;
+        sheet.height = images[path].getSize().y;
+    }
+
+    unsigned height = pack();
+    sf::Image atlas;
+    atlas.create(ATLAS_WIDTH, std::max(height, 1u), sf::Color::Transparent);
+    for (const auto& [path, sheet] : _sheets) {
+        if (sheet.packed)
+            atlas.copy(images[path], sheet.x, sheet.y);
+    }
+
+    std::filesystem::create_directories(_out_dir);
+    std::string atlas_path = _out_dir + "/" + ATLAS_IMAGE;
+    if (!atlas.saveToFile(atlas_path)) {
+        std::cerr << "atlas: cannot write " << atlas_path << "\n";
+        return false;
+    }
+    std::cerr << "atlas: " << ATLAS_WIDTH << "x" << height << " -> "
+        << atlas_path << "\n";
+
+    bool ok = true;
+    for (const auto& toml : _configs)
+        ok = writeConfig(toml) && ok;
+    return ok;
+}
+
+bool AtlasPacker::writeConfig(const std::string& toml) const {
+    std::ifstream in(toml);
+    std::string out_path = _out_dir + "/"
+        + std::filesystem::path(toml).filename().string();
+    std::ofstream out(out_path);
+    if (!in.is_open() || !out.is_open()) {
+        std::cerr << "atlas: cannot write " << out_path << "\n";
+        return false;
+    }
+
+    std::string atlas_path = normalize(_out_dir + "/" + ATLAS_IMAGE);
+    const Sheet* current = nullptr;
+    std::string line;
+    std::smatch match;
+
+    while (std::getline(in, line)) {
+        if (std::regex_match(line, match, PATH_LINE)) {
+            auto it = _sheets.find(normalize(match[2]));
+            current = it != _sheets.end() && it->second.packed
+                ? &it->second : nullptr;
+            if (current != nullptr)
+                line = match[1].str() + atlas_path + match[3].str();
+        } else if (current != nullptr) {
+            std::string shifted;
+            auto begin = line.cbegin();
+            while (std::regex_search(begin, line.cend(), match,
+                FRAME_COORDS)) {
+                shifted += match.prefix().str() + "[["
+                    + std::to_string(std::stoul(match[1])
+                        + current->x / current->frame_w) + ", "
+                    + std::to_string(std::stoul(match[2])
+                        + current->y / current->frame_h) + "]";
+                begin = match.suffix().first;
+            }
+            line = shifted + std::string(begin, line.cend());
+        }
+        out << line << "\n";
+    }
+    return true;
+}
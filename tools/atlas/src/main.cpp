@@ -0,0 +1,23 @@
+/*
+** EPITECH PROJECT, 2025
+** GameOne
+** File description:
+** atlas_main.cpp
+** Copyright [2025] <DeepestDungeonGroup>
+*/
+
+#include <iostream>
+#include <AtlasPacker.hpp>
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <out_dir> <sprite.toml>...\n";
+        return 1;
+    }
+
+    AtlasPacker packer(argv[1]);
+
+    for (int i = 2; i < argc; ++i)
+        packer.addConfig(argv[i]);
+    return packer.write() ? 0 : 1;
+}